@@ -0,0 +1,196 @@
+/**
+ * @file arena.c
+ * @brief Implementation of the bump allocator
+ */
+
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Allocation granularity: enough for pointers, size_t and 64-bit values */
+#define ARENA_ALIGNMENT 16
+
+/* Rounds n up to a multiple of ARENA_ALIGNMENT */
+#define ALIGN_UP(n) (((n) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+/* Helper: One block of arena memory; the data follows the header */
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;  /* Older block */
+    size_t size;              /* Usable bytes after the header */
+    size_t used;              /* Bytes handed out so far */
+} ArenaBlock;
+
+struct Arena {
+    ArenaBlock* current;      /* Block that small allocations come from */
+    size_t blockSize;         /* Usable bytes of a regular block */
+    void* last;               /* Most recent allocation in current, for arenaGrow() */
+};
+
+/* Size of a block header, rounded so the data stays aligned */
+#define BLOCK_HEADER ALIGN_UP(sizeof(ArenaBlock))
+
+/* First data byte of a block */
+#define BLOCK_DATA(block) ((unsigned char*)(block) + BLOCK_HEADER)
+
+/* Helper: Allocate a block with room for size bytes */
+static ArenaBlock* createBlock(size_t size) {
+    ArenaBlock* block = (ArenaBlock*)malloc(BLOCK_HEADER + size);
+    if (block == NULL) return NULL;
+
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+/**
+ * @brief Creates an empty arena
+ */
+Arena* createArena(size_t blockSize) {
+    Arena* arena = (Arena*)malloc(sizeof(Arena));
+    if (arena == NULL) return NULL;
+
+    arena->current = NULL;
+    arena->blockSize = ALIGN_UP(blockSize != 0 ? blockSize : ARENA_BLOCK_SIZE);
+    arena->last = NULL;
+    return arena;
+}
+
+/**
+ * @brief Allocates memory from an arena
+ */
+void* arenaAlloc(Arena* arena, size_t size) {
+    ArenaBlock* block;
+    void* ptr;
+
+    if (arena == NULL) return NULL;
+    if (size > (size_t)-1 - BLOCK_HEADER - ARENA_ALIGNMENT) return NULL;
+    size = ALIGN_UP(size != 0 ? size : 1);
+
+    /* Fast path: bump the pointer in the current block */
+    block = arena->current;
+    if (block != NULL && size <= block->size - block->used) {
+        ptr = BLOCK_DATA(block) + block->used;
+        block->used += size;
+        arena->last = ptr;
+        return ptr;
+    }
+
+    /* Oversized request: a dedicated block behind the current one */
+    if (size > arena->blockSize && block != NULL) {
+        ArenaBlock* large = createBlock(size);
+        if (large == NULL) return NULL;
+
+        large->used = size;
+        large->next = block->next;
+        block->next = large;
+        return BLOCK_DATA(large);
+    }
+
+    /* Start a new current block */
+    block = createBlock(size > arena->blockSize ? size : arena->blockSize);
+    if (block == NULL) return NULL;
+
+    block->next = arena->current;
+    block->used = size;
+    arena->current = block;
+    arena->last = BLOCK_DATA(block);
+    return arena->last;
+}
+
+/**
+ * @brief Grows an allocation made from an arena
+ */
+void* arenaGrow(Arena* arena, void* ptr, size_t oldSize, size_t newSize) {
+    ArenaBlock* block;
+    void* grown;
+    size_t offset;
+
+    if (arena == NULL) return NULL;
+    if (ptr == NULL) return arenaAlloc(arena, newSize);
+    if (newSize <= oldSize) return ptr;
+
+    /* The most recent allocation can simply take more of its block */
+    block = arena->current;
+    if (ptr == arena->last && newSize <= (size_t)-1 - ARENA_ALIGNMENT) {
+        offset = (size_t)((unsigned char*)ptr - BLOCK_DATA(block));
+        if (ALIGN_UP(newSize) <= block->size - offset) {
+            block->used = offset + ALIGN_UP(newSize);
+            return ptr;
+        }
+    }
+
+    grown = arenaAlloc(arena, newSize);
+    if (grown == NULL) return NULL;
+
+    memcpy(grown, ptr, oldSize);
+    return grown;
+}
+
+/**
+ * @brief Allocates from an arena if there is one, else from the heap
+ */
+void* arenaOrHeapAlloc(Arena* arena, size_t size) {
+    return arena != NULL ? arenaAlloc(arena, size) : malloc(size);
+}
+
+/**
+ * @brief Grows an allocation made with arenaOrHeapAlloc()
+ */
+void* arenaOrHeapGrow(Arena* arena, void* ptr, size_t oldSize, size_t newSize) {
+    return arena != NULL ? arenaGrow(arena, ptr, oldSize, newSize) : realloc(ptr, newSize);
+}
+
+/**
+ * @brief Frees an allocation made with arenaOrHeapAlloc()
+ */
+void arenaOrHeapFree(Arena* arena, void* ptr) {
+    if (arena == NULL) {
+        free(ptr);
+    }
+}
+
+/**
+ * @brief Releases every allocation made from an arena
+ */
+void resetArena(Arena* arena) {
+    ArenaBlock* block;
+    ArenaBlock* next;
+    ArenaBlock* kept;
+
+    if (arena == NULL) return;
+
+    /* Keep one regular-sized block, free the rest */
+    kept = NULL;
+    for (block = arena->current; block != NULL; block = next) {
+        next = block->next;
+        if (kept == NULL && block->size == arena->blockSize) {
+            kept = block;
+        } else {
+            free(block);
+        }
+    }
+
+    if (kept != NULL) {
+        kept->next = NULL;
+        kept->used = 0;
+    }
+    arena->current = kept;
+    arena->last = NULL;
+}
+
+/**
+ * @brief Frees an arena and all of its blocks
+ */
+void destroyArena(Arena* arena) {
+    ArenaBlock* block;
+    ArenaBlock* next;
+
+    if (arena == NULL) return;
+
+    for (block = arena->current; block != NULL; block = next) {
+        next = block->next;
+        free(block);
+    }
+    free(arena);
+}
@@ -0,0 +1,108 @@
+/**
+ * @file arena.h
+ * @brief Bump allocator for short-lived allocations
+ *
+ * An arena hands out memory from large blocks by advancing a pointer.
+ * Individual allocations are never freed; resetArena() releases them
+ * all at once. The calculator uses one arena per evaluated expression
+ * for tokens, evaluation stacks and intermediate BigNums.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/**
+ * @brief Default size of an arena block in bytes
+ */
+#define ARENA_BLOCK_SIZE 65536
+
+/**
+ * @brief Opaque arena handle
+ */
+typedef struct Arena Arena;
+
+/**
+ * @brief Creates an empty arena
+ *
+ * @param blockSize Size of each block in bytes (0 for ARENA_BLOCK_SIZE)
+ * @return Pointer to newly allocated arena, or NULL on error
+ */
+Arena* createArena(size_t blockSize);
+
+/**
+ * @brief Allocates memory from an arena
+ *
+ * The memory is suitably aligned for any type used by the calculator
+ * and stays valid until the arena is reset or destroyed. Requests
+ * larger than the block size get a block of their own.
+ *
+ * @param arena Arena to allocate from
+ * @param size Number of bytes
+ * @return Pointer to the memory, or NULL on error
+ */
+void* arenaAlloc(Arena* arena, size_t size);
+
+/**
+ * @brief Grows an allocation made from an arena
+ *
+ * Extends the allocation in place when it is the most recent one and
+ * the block has room, otherwise copies it to a new allocation.
+ *
+ * @param arena Arena the allocation came from
+ * @param ptr Existing allocation (may be NULL)
+ * @param oldSize Current size of the allocation in bytes
+ * @param newSize Requested size in bytes
+ * @return Pointer to the grown allocation, or NULL on error
+ */
+void* arenaGrow(Arena* arena, void* ptr, size_t oldSize, size_t newSize);
+
+/**
+ * @brief Allocates from an arena if there is one, else from the heap
+ *
+ * @param arena Arena to allocate from, or NULL for malloc()
+ * @param size Number of bytes
+ * @return Pointer to the memory, or NULL on error
+ */
+void* arenaOrHeapAlloc(Arena* arena, size_t size);
+
+/**
+ * @brief Grows an allocation made with arenaOrHeapAlloc()
+ *
+ * @param arena Arena the allocation came from, or NULL for realloc()
+ * @param ptr Existing allocation (may be NULL)
+ * @param oldSize Current size of the allocation in bytes
+ * @param newSize Requested size in bytes
+ * @return Pointer to the grown allocation, or NULL on error
+ */
+void* arenaOrHeapGrow(Arena* arena, void* ptr, size_t oldSize, size_t newSize);
+
+/**
+ * @brief Frees an allocation made with arenaOrHeapAlloc()
+ *
+ * Heap memory is freed; arena memory is left for resetArena().
+ *
+ * @param arena Arena the allocation came from, or NULL for free()
+ * @param ptr Allocation to free (may be NULL)
+ */
+void arenaOrHeapFree(Arena* arena, void* ptr);
+
+/**
+ * @brief Releases every allocation made from an arena
+ *
+ * Keeps one block for reuse, so an arena reset after each expression
+ * normally needs no further calls to malloc().
+ *
+ * @param arena Arena to reset
+ */
+void resetArena(Arena* arena);
+
+/**
+ * @brief Frees an arena and all of its blocks
+ *
+ * @param arena Arena to free (may be NULL)
+ */
+void destroyArena(Arena* arena);
+
+#endif /* ARENA_H */
@@ -4,32 +4,53 @@
  */
 
 #include "bignum.h"
+#include "bignum_limbs.h"
 #include "utils.h"
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 
-/* Helper function to remove leading zeros from a string of digits */
-static char* removeLeadingZeros(char* digits) {
-    char* p = digits;
+/* Arena that new BigNums are allocated from, or NULL for the heap */
+static Arena* bigNumArena = NULL;
 
-    /* Skip leading zeros */
-    while (*p == '0' && *(p + 1) != '\0') {
-        p++;
-    }
+/* Smallest heap limb array; pool classes hold POOL_MIN_LIMBS << k limbs */
+#define POOL_MIN_LIMBS 4
 
-    /* Move result to beginning if needed */
-    if (p != digits) {
-        char* src = p;
-        char* dest = digits;
-        while (*src != '\0') {
-            *dest++ = *src++;
-        }
-        *dest = '\0';
-    }
+/* Number of size classes (largest: 4 << 13 = 32768 limbs, 128 KB) */
+#define POOL_CLASSES 14
 
-    return digits;
-}
+/* Released structs or arrays kept per free list */
+#define POOL_MAX_FREE 32
+
+/* Header in front of every non-inline limb array: BigNums sharing it */
+typedef struct {
+    size_t refs;
+} LimbHeader;
+
+#define LIMB_HEADER(limbs) ((LimbHeader*)(limbs) - 1)
+
+/* True if num's limbs are shared with another BigNum */
+#define IS_SHARED(num) \
+    (!((num)->storage & BIGNUM_STORAGE_INLINE) && LIMB_HEADER((num)->limbs)->refs > 1)
+
+/* Free lists of heap BigNum structs and of limb arrays by size class */
+static BigNum* freeStructs[POOL_MAX_FREE];
+static size_t freeStructCount = 0;
+static Limb* freeLimbs[POOL_CLASSES][POOL_MAX_FREE];
+static size_t freeLimbCount[POOL_CLASSES];
+
+/* Shared small constants, filled in on first use */
+static BigNum constants[BIGNUM_CONSTANT_MAX - BIGNUM_CONSTANT_MIN + 1];
+static bool constantsReady = false;
+
+/* Number of decimal digits that always fit in one limb */
+#define DIGITS_PER_LIMB 9
+
+/* Powers of ten up to 10^DIGITS_PER_LIMB */
+static const Limb POWERS_OF_TEN[DIGITS_PER_LIMB + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000,
+    10000000, 100000000, 1000000000
+};
 
 /**
  * @brief Creates a new BigNum from a decimal string
@@ -37,7 +58,7 @@ static char* removeLeadingZeros(char* digits) {
 BigNum* createBigNum(const char* str) {
     BigNum* num;
     const char* p;
-    char* digitsStart;
+    const char* digitsStart;
     size_t len;
     bool negative;
 
@@ -45,12 +66,6 @@ BigNum* createBigNum(const char* str) {
         return NULL;
     }
 
-    /* Allocate BigNum structure */
-    num = (BigNum*)malloc(sizeof(BigNum));
-    if (num == NULL) {
-        return NULL;
-    }
-
     /* Skip whitespace */
     p = str;
     while (isspace((unsigned char)*p)) {
@@ -66,73 +81,350 @@ BigNum* createBigNum(const char* str) {
         p++;
     }
 
-    /* Validate and count digits */
-    digitsStart = (char*)p;
-    len = 0;
-    while (*p != '\0') {
-        if (!isDigitChar(*p)) {
-            free(num);
-            return NULL;
-        }
-        len++;
-        p++;
+    /* Validate and count digits, a block of characters at a time */
+    digitsStart = p;
+    len = strlen(p);
+    if (spanDecimalDigits(p, len) != len) {
+        return NULL;
     }
 
     /* Empty digits */
     if (len == 0) {
-        free(num);
         return NULL;
     }
 
-    /* Allocate and copy digits */
-    num->digits = (char*)malloc(len + 1);
-    if (num->digits == NULL) {
-        free(num);
+    num = createBigNumFromDigits(digitsStart, len);
+    if (num == NULL) {
         return NULL;
     }
 
-    memcpy(num->digits, digitsStart, len);
-    num->digits[len] = '\0';
+    /* Zero is never negative */
+    num->isNegative = negative && num->length > 0;
 
-    /* Remove leading zeros */
-    removeLeadingZeros(num->digits);
+    return num;
+}
 
-    /* Zero is never negative */
-    if (strcmp(num->digits, "0") == 0) {
-        num->isNegative = false;
-    } else {
-        num->isNegative = negative;
+/**
+ * @brief Creates a non-negative BigNum from a run of decimal digits
+ */
+BigNum* createBigNumFromDigits(const char* digits, size_t len) {
+    BigNum* num;
+    const char* p;
+    size_t chunk;
+
+    /* Each chunk of DIGITS_PER_LIMB digits adds at most one limb */
+    num = createBigNumWithCapacity(len / DIGITS_PER_LIMB + 1);
+    if (num == NULL) {
+        return NULL;
+    }
+
+    /* Accumulate digits in chunks: num = num * 10^chunk + value */
+    p = digits;
+    chunk = len % DIGITS_PER_LIMB;
+    if (chunk == 0) {
+        chunk = DIGITS_PER_LIMB;
+    }
+    while (len > 0) {
+        Limb value = 0;
+        Limb carry;
+        size_t i;
+
+        if (chunk == DIGITS_PER_LIMB) {
+            /* Full chunk: eight digits at once, then the ninth */
+            value = (Limb)parseEightDigits(p) * 10 + (Limb)(p[8] - '0');
+            p += DIGITS_PER_LIMB;
+        } else {
+            for (i = 0; i < chunk; i++) {
+                value = value * 10 + (Limb)(*p++ - '0');
+            }
+        }
+
+        carry = limbsMulAdd1(num->limbs, num->limbs, num->length,
+                             POWERS_OF_TEN[chunk], value);
+        if (carry != 0) {
+            num->limbs[num->length++] = carry;
+        }
+
+        len -= chunk;
+        chunk = DIGITS_PER_LIMB;
     }
 
     return num;
 }
 
+/**
+ * @brief Returns a shared constant BigNum for a small integer
+ */
+const BigNum* bigNumConstant(int value) {
+    size_t i;
+
+    if (value < BIGNUM_CONSTANT_MIN || value > BIGNUM_CONSTANT_MAX) {
+        return NULL;
+    }
+
+    if (!constantsReady) {
+        for (i = 0; i < sizeof(constants) / sizeof(constants[0]); i++) {
+            int v = (int)i + BIGNUM_CONSTANT_MIN;
+            BigNum* c = &constants[i];
+
+            /* Inline limbs: copies never share or free anything */
+            c->limbs = c->small;
+            c->small[0] = (Limb)(v < 0 ? -v : v);
+            c->small[1] = 0;
+            c->length = v != 0 ? 1 : 0;
+            c->capacity = BIGNUM_INLINE_LIMBS;
+            c->isNegative = v < 0;
+            c->storage = BIGNUM_STORAGE_INLINE;
+        }
+        constantsReady = true;
+    }
+
+    return &constants[value - BIGNUM_CONSTANT_MIN];
+}
+
 /**
  * @brief Creates a new BigNum initialized to zero
  */
 BigNum* createBigNumZero(void) {
+    return createBigNumWithCapacity(1);
+}
+
+/**
+ * @brief Sets the arena that new BigNums are allocated from
+ */
+Arena* setBigNumArena(Arena* arena) {
+    Arena* previous = bigNumArena;
+
+    bigNumArena = arena;
+    return previous;
+}
+
+/* Helper: Size class for a heap limb array, or POOL_CLASSES if too large */
+static size_t poolClass(size_t capacity) {
+    size_t cls = 0;
+
+    while (cls < POOL_CLASSES && ((size_t)POOL_MIN_LIMBS << cls) < capacity) {
+        cls++;
+    }
+    return cls;
+}
+
+/* Helper: Allocate a limb array and its header with malloc() */
+static Limb* mallocLimbs(size_t capacity) {
+    LimbHeader* header = (LimbHeader*)malloc(sizeof(LimbHeader) + capacity * sizeof(Limb));
+
+    return header != NULL ? (Limb*)(header + 1) : NULL;
+}
+
+/* Helper: Take a heap limb array, rounding *capacity up to its size class */
+static Limb* allocHeapLimbs(size_t* capacity) {
+    size_t cls = poolClass(*capacity);
+
+    if (cls == POOL_CLASSES) {
+        return mallocLimbs(*capacity);
+    }
+
+    *capacity = (size_t)POOL_MIN_LIMBS << cls;
+    if (freeLimbCount[cls] > 0) {
+        return freeLimbs[cls][--freeLimbCount[cls]];
+    }
+    return mallocLimbs(*capacity);
+}
+
+/* Helper: Return a heap limb array to its free list, or free it */
+static void releaseHeapLimbs(Limb* limbs, size_t capacity) {
+    size_t cls = poolClass(capacity);
+
+    /* Only arrays whose capacity is exactly a class size came from the pool */
+    if (cls < POOL_CLASSES && ((size_t)POOL_MIN_LIMBS << cls) == capacity &&
+        freeLimbCount[cls] < POOL_MAX_FREE) {
+        freeLimbs[cls][freeLimbCount[cls]++] = limbs;
+        return;
+    }
+    free(LIMB_HEADER(limbs));
+}
+
+/* Helper: Allocate a limb array from the current arena or the pool,
+ * rounding *capacity up and recording the source in *storage */
+static Limb* allocLimbs(size_t* capacity, unsigned char* storage) {
+    LimbHeader* header;
+    Limb* limbs;
+
+    *storage &= (unsigned char)~(BIGNUM_STORAGE_ARENA_LIMBS | BIGNUM_STORAGE_INLINE);
+
+    /* Small limb arrays share the arena too; large ones stay freeable */
+    if (bigNumArena != NULL && *capacity <= BIGNUM_ARENA_MAX_LIMBS) {
+        *storage |= BIGNUM_STORAGE_ARENA_LIMBS;
+        header = (LimbHeader*)arenaAlloc(bigNumArena,
+                                         sizeof(LimbHeader) + *capacity * sizeof(Limb));
+        limbs = header != NULL ? (Limb*)(header + 1) : NULL;
+    } else {
+        limbs = allocHeapLimbs(capacity);
+    }
+
+    if (limbs != NULL) {
+        LIMB_HEADER(limbs)->refs = 1;
+    }
+    return limbs;
+}
+
+/* Helper: Drop num's reference to its limbs, recycling them if it was the last */
+static void releaseLimbs(BigNum* num) {
+    if (num->storage & BIGNUM_STORAGE_INLINE) {
+        return;
+    }
+    if (--LIMB_HEADER(num->limbs)->refs > 0) {
+        return;
+    }
+
+    /* Arena-owned arrays are released by resetArena(), the rest is pooled */
+    if (!(num->storage & BIGNUM_STORAGE_ARENA_LIMBS)) {
+        releaseHeapLimbs(num->limbs, num->capacity);
+    }
+}
+
+/**
+ * @brief Releases the BigNum structs and limb arrays kept for reuse
+ */
+void clearBigNumPool(void) {
+    size_t cls;
+
+    while (freeStructCount > 0) {
+        free(freeStructs[--freeStructCount]);
+    }
+    for (cls = 0; cls < POOL_CLASSES; cls++) {
+        while (freeLimbCount[cls] > 0) {
+            free(LIMB_HEADER(freeLimbs[cls][--freeLimbCount[cls]]));
+        }
+    }
+}
+
+/**
+ * @brief Creates a new zero BigNum with room for a given number of limbs
+ */
+BigNum* createBigNumWithCapacity(size_t capacity) {
     BigNum* num;
 
-    num = (BigNum*)malloc(sizeof(BigNum));
+    if (capacity == 0) {
+        capacity = 1;
+    }
+
+    if (bigNumArena != NULL) {
+        num = (BigNum*)arenaAlloc(bigNumArena, sizeof(BigNum));
+    } else if (freeStructCount > 0) {
+        num = freeStructs[--freeStructCount];
+    } else {
+        num = (BigNum*)malloc(sizeof(BigNum));
+    }
     if (num == NULL) {
         return NULL;
     }
+    num->storage = bigNumArena != NULL ? BIGNUM_STORAGE_ARENA_STRUCT : 0;
 
-    num->digits = (char*)malloc(2);
-    if (num->digits == NULL) {
-        free(num);
+    /* Small values live in the struct itself */
+    if (capacity <= BIGNUM_INLINE_LIMBS) {
+        capacity = BIGNUM_INLINE_LIMBS;
+        num->limbs = num->small;
+        num->storage |= BIGNUM_STORAGE_INLINE;
+    } else {
+        num->limbs = allocLimbs(&capacity, &num->storage);
+    }
+    if (num->limbs == NULL) {
+        if (!(num->storage & BIGNUM_STORAGE_ARENA_STRUCT)) {
+            free(num);
+        }
         return NULL;
     }
 
-    num->digits[0] = '0';
-    num->digits[1] = '\0';
     num->isNegative = false;
+    num->length = 0;
+    num->capacity = capacity;
 
     return num;
 }
 
 /**
- * @brief Creates a deep copy of a BigNum
+ * @brief Makes a BigNum's limbs writable with room for at least capacity limbs
+ */
+bool reserveBigNum(BigNum* num, size_t capacity) {
+    Limb* limbs;
+    unsigned char storage;
+
+    if (num == NULL) {
+        return false;
+    }
+    if (capacity <= num->capacity) {
+        if (!IS_SHARED(num)) {
+            return true;
+        }
+
+        /* Copy on write: keep the capacity, just stop sharing */
+        capacity = num->capacity;
+    } else if (capacity < 2 * num->capacity) {
+        /* Grow geometrically so accumulating loops reallocate rarely */
+        capacity = 2 * num->capacity;
+    }
+
+    storage = num->storage;
+    limbs = allocLimbs(&capacity, &storage);
+    if (limbs == NULL) {
+        return false;
+    }
+    memcpy(limbs, num->limbs, num->length * sizeof(Limb));
+
+    releaseLimbs(num);
+    num->limbs = limbs;
+    num->capacity = capacity;
+    num->storage = storage;
+
+    return true;
+}
+
+/**
+ * @brief Exchanges the values of two BigNums
+ */
+void swapBigNum(BigNum* a, BigNum* b) {
+    BigNum t;
+    unsigned char structFlags;
+
+    if (a == NULL || b == NULL) {
+        return;
+    }
+
+    /* The limbs move with the value; each struct keeps its own origin */
+    t = *a;
+    *a = *b;
+    *b = t;
+
+    structFlags = (unsigned char)((a->storage ^ b->storage) & BIGNUM_STORAGE_ARENA_STRUCT);
+    a->storage ^= structFlags;
+    b->storage ^= structFlags;
+
+    /* Inline limbs were copied along with the struct */
+    if (a->storage & BIGNUM_STORAGE_INLINE) {
+        a->limbs = a->small;
+    }
+    if (b->storage & BIGNUM_STORAGE_INLINE) {
+        b->limbs = b->small;
+    }
+}
+
+/**
+ * @brief Trims high zero limbs and clears the sign of zero
+ */
+void normalizeBigNum(BigNum* num) {
+    if (num == NULL) {
+        return;
+    }
+
+    num->length = limbsNormalize(num->limbs, num->length);
+    if (num->length == 0) {
+        num->isNegative = false;
+    }
+}
+
+/**
+ * @brief Creates a copy of a BigNum, sharing its limbs
  */
 BigNum* copyBigNum(const BigNum* num) {
     BigNum* copy;
@@ -141,17 +433,32 @@ BigNum* copyBigNum(const BigNum* num) {
         return NULL;
     }
 
-    copy = (BigNum*)malloc(sizeof(BigNum));
-    if (copy == NULL) {
-        return NULL;
+    /* Share the limbs unless they are inline or die with the current arena
+     * while the copy would not */
+    if (!(num->storage & BIGNUM_STORAGE_INLINE) &&
+        !(bigNumArena == NULL && (num->storage & BIGNUM_STORAGE_ARENA_LIMBS))) {
+        copy = createBigNumWithCapacity(BIGNUM_INLINE_LIMBS);
+        if (copy == NULL) {
+            return NULL;
+        }
+
+        copy->limbs = num->limbs;
+        copy->length = num->length;
+        copy->capacity = num->capacity;
+        copy->isNegative = num->isNegative;
+        copy->storage = (unsigned char)((copy->storage & BIGNUM_STORAGE_ARENA_STRUCT) |
+                                        (num->storage & BIGNUM_STORAGE_ARENA_LIMBS));
+        LIMB_HEADER(num->limbs)->refs++;
+        return copy;
     }
 
-    copy->digits = stringDuplicate(num->digits);
-    if (copy->digits == NULL) {
-        free(copy);
+    copy = createBigNumWithCapacity(num->length);
+    if (copy == NULL) {
         return NULL;
     }
 
+    memcpy(copy->limbs, num->limbs, num->length * sizeof(Limb));
+    copy->length = num->length;
     copy->isNegative = num->isNegative;
 
     return copy;
@@ -165,22 +472,29 @@ void destroyBigNum(BigNum* num) {
         return;
     }
 
-    if (num->digits != NULL) {
-        free(num->digits);
+    /* Arena-owned parts are released by resetArena(), the rest is pooled */
+    if (num->limbs != NULL) {
+        releaseLimbs(num);
     }
 
-    free(num);
+    if (!(num->storage & BIGNUM_STORAGE_ARENA_STRUCT)) {
+        if (freeStructCount < POOL_MAX_FREE) {
+            freeStructs[freeStructCount++] = num;
+        } else {
+            free(num);
+        }
+    }
 }
 
 /**
  * @brief Checks if a BigNum is zero
  */
 bool isZero(const BigNum* num) {
-    if (num == NULL || num->digits == NULL) {
+    if (num == NULL || num->limbs == NULL) {
         return false;
     }
 
-    return strcmp(num->digits, "0") == 0;
+    return num->length == 0;
 }
 
 /**
@@ -191,12 +505,12 @@ bool isEqual(const BigNum* a, const BigNum* b) {
         return false;
     }
 
-    /* Same sign and same digits */
+    /* Same sign and same magnitude */
     if (a->isNegative != b->isNegative) {
         return false;
     }
 
-    return strcmp(a->digits, b->digits) == 0;
+    return limbsCompare(a->limbs, a->length, b->limbs, b->length) == 0;
 }
 
 /**
@@ -204,25 +518,11 @@ bool isEqual(const BigNum* a, const BigNum* b) {
  * @return true if |a| < |b|, false otherwise
  */
 bool isLessAbs(const BigNum* a, const BigNum* b) {
-    size_t lenA, lenB;
-
     if (a == NULL || b == NULL) {
         return false;
     }
 
-    lenA = strlen(a->digits);
-    lenB = strlen(b->digits);
-
-    /* Compare lengths first */
-    if (lenA < lenB) {
-        return true;
-    }
-    if (lenA > lenB) {
-        return false;
-    }
-
-    /* Same length - compare lexicographically */
-    return strcmp(a->digits, b->digits) < 0;
+    return limbsCompare(a->limbs, a->length, b->limbs, b->length) < 0;
 }
 
 /**
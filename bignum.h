@@ -10,19 +10,107 @@
 #ifndef BIGNUM_H
 #define BIGNUM_H
 
+#include "arena.h"
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief One base-2^32 digit of a magnitude */
+typedef uint32_t Limb;
+
+/** @brief Unsigned type wide enough for a full Limb x Limb product */
+typedef uint64_t DoubleLimb;
+
+/** @brief Number of bits in a Limb */
+#define LIMB_BITS 32
+
+/** @brief Limbs stored inside the BigNum struct itself (one 64-bit word) */
+#define BIGNUM_INLINE_LIMBS 2
 
 /**
  * @brief Structure representing an arbitrary precision integer
  *
- * The number is stored as a decimal string with a separate sign flag.
- * This representation simplifies arithmetic operations and debugging.
+ * The magnitude is stored as an array of base-2^32 limbs, least
+ * significant limb first, with a separate sign flag. The array is kept
+ * normalized: the top limb in use is never zero, and zero has length 0.
+ *
+ * Values of up to BIGNUM_INLINE_LIMBS limbs are stored inline: limbs
+ * then points at the struct's own small array, so creating one needs no
+ * separate allocation and every limb routine works unchanged.
+ *
+ * Larger limb arrays are reference counted and shared by copyBigNum(),
+ * so a value is immutable once created: only the function that just
+ * allocated a BigNum writes its limbs directly, and everything else goes
+ * through reserveBigNum(), which copies shared limbs before writing.
  */
 typedef struct {
-    bool isNegative;  /**< Sign flag: true for negative, false for non-negative */
-    char* digits;     /**< Null-terminated string of decimal digits (no sign) */
+    bool isNegative;        /**< Sign flag: true for negative, false for non-negative */
+    Limb* limbs;            /**< Magnitude limbs, least significant first */
+    size_t length;          /**< Number of limbs in use (0 for zero) */
+    size_t capacity;        /**< Number of limbs allocated */
+    unsigned char storage;  /**< BIGNUM_STORAGE_* flags: where the parts live */
+    Limb small[BIGNUM_INLINE_LIMBS];  /**< Inline limbs for small values */
 } BigNum;
 
+/** @brief Storage flag: the BigNum struct was allocated from an arena */
+#define BIGNUM_STORAGE_ARENA_STRUCT 0x01
+
+/** @brief Storage flag: the limb array was allocated from an arena */
+#define BIGNUM_STORAGE_ARENA_LIMBS 0x02
+
+/** @brief Storage flag: the limbs are the struct's inline small array */
+#define BIGNUM_STORAGE_INLINE 0x04
+
+/**
+ * @brief Largest limb array (in limbs) taken from an arena
+ *
+ * Bigger arrays come from the heap so they can be freed as soon as the
+ * BigNum is destroyed instead of waiting for the arena reset.
+ */
+#define BIGNUM_ARENA_MAX_LIMBS 4096
+
+/**
+ * @brief Sets the arena that new BigNums are allocated from
+ *
+ * While an arena is set, every BigNum created by this module and the
+ * operations built on it lives in that arena: destroyBigNum() releases
+ * only parts that came from the heap, and the rest disappears with
+ * resetArena(). Results that must outlive the arena have to be copied
+ * with copyBigNum() after setting the arena back to NULL.
+ *
+ * @param arena Arena to allocate from, or NULL for the heap
+ * @return The previously set arena, for restoring it later
+ */
+Arena* setBigNumArena(Arena* arena);
+
+/**
+ * @brief Releases the BigNum structs and limb arrays kept for reuse
+ *
+ * Heap BigNums are recycled through free lists: destroyBigNum() keeps
+ * structs and limb arrays up to 32768 limbs (rounded to power-of-two
+ * size classes) for the next createBigNumWithCapacity(). Call this at
+ * shutdown to hand the cached memory back to the system.
+ */
+void clearBigNumPool(void);
+
+/** @brief Smallest value available from bigNumConstant() */
+#define BIGNUM_CONSTANT_MIN (-1)
+
+/** @brief Largest value available from bigNumConstant() */
+#define BIGNUM_CONSTANT_MAX 16
+
+/**
+ * @brief Returns a shared constant BigNum for a small integer
+ *
+ * The constants live in a static table that is never freed, so they
+ * cost nothing to use in loops. They must not be modified or destroyed;
+ * copyBigNum() gives a private copy when a new BigNum has to be returned.
+ *
+ * @param value Integer between BIGNUM_CONSTANT_MIN and BIGNUM_CONSTANT_MAX
+ * @return Pointer to the constant, or NULL if value is out of range
+ */
+const BigNum* bigNumConstant(int value);
+
 /**
  * @brief Creates a new BigNum from a decimal string
  *
@@ -31,6 +119,18 @@ typedef struct {
  */
 BigNum* createBigNum(const char* str);
 
+/**
+ * @brief Creates a non-negative BigNum from a run of decimal digits
+ *
+ * Converts nine digits per limb operation, in time quadratic in len.
+ * The digits need not be NUL-terminated and are not validated.
+ *
+ * @param digits Decimal digits '0'-'9', most significant first
+ * @param len Number of digits to read
+ * @return Pointer to newly allocated BigNum, or NULL on error
+ */
+BigNum* createBigNumFromDigits(const char* digits, size_t len);
+
 /**
  * @brief Creates a new BigNum initialized to zero
  *
@@ -39,7 +139,52 @@ BigNum* createBigNum(const char* str);
 BigNum* createBigNumZero(void);
 
 /**
- * @brief Creates a deep copy of a BigNum
+ * @brief Creates a new zero BigNum with room for a given number of limbs
+ *
+ * Used by arithmetic routines that write their result limbs directly.
+ *
+ * @param capacity Number of limbs to allocate (at least 1 is allocated)
+ * @return Pointer to newly allocated BigNum representing 0, or NULL on error
+ */
+BigNum* createBigNumWithCapacity(size_t capacity);
+
+/**
+ * @brief Makes a BigNum's limbs writable with room for at least capacity limbs
+ *
+ * Keeps the value; a new limb array is allocated (growing at least
+ * geometrically) only when the current one is too small or shared with
+ * another BigNum (copy on write). Used by the in-place arithmetic in
+ * bignum_ops.h before it modifies any limbs.
+ *
+ * @param num BigNum to prepare
+ * @param capacity Number of limbs needed
+ * @return true on success, false on allocation failure
+ */
+bool reserveBigNum(BigNum* num, size_t capacity);
+
+/**
+ * @brief Exchanges the values of two BigNums
+ *
+ * Swaps sign, limbs, length and capacity without copying any heap limbs.
+ *
+ * @param a First BigNum
+ * @param b Second BigNum
+ */
+void swapBigNum(BigNum* a, BigNum* b);
+
+/**
+ * @brief Trims high zero limbs and clears the sign of zero
+ *
+ * @param num BigNum whose length may include high zero limbs
+ */
+void normalizeBigNum(BigNum* num);
+
+/**
+ * @brief Creates a copy of a BigNum
+ *
+ * Takes O(1) time: the copy shares the limb array and bumps its
+ * reference count. Limbs owned by an arena are copied instead when no
+ * arena is set, so the copy can outlive the arena.
  *
  * @param num BigNum to copy
  * @return Pointer to newly allocated copy, or NULL on error
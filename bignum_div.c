@@ -0,0 +1,269 @@
+/**
+ * @file bignum_div.c
+ * @brief Implementation of Knuth Algorithm D and Burnikel-Ziegler division
+ */
+
+#include "bignum_div.h"
+#include "bignum_limbs.h"
+#include "bignum_mul.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Helper: Algorithm D core on normalized operands
+ *
+ * u has uLen + 1 limbs (top limb may be zero) and v has vLen >= 2 limbs
+ * with its top bit set. Leaves the remainder in the low vLen limbs of u.
+ */
+static void divideNormalized(Limb* q, Limb* u, size_t uLen, const Limb* v, size_t vLen) {
+    DoubleLimb numerator, qhat, rhat;
+    Limb vTop, vNext, borrow;
+    size_t j;
+
+    vTop = v[vLen - 1];
+    vNext = v[vLen - 2];
+
+    for (j = uLen - vLen + 1; j > 0; j--) {
+        Limb* window = u + j - 1;
+
+        /* Estimate the quotient limb from the top two limbs */
+        numerator = ((DoubleLimb)window[vLen] << LIMB_BITS) | window[vLen - 1];
+        qhat = numerator / vTop;
+        rhat = numerator % vTop;
+
+        /* Correct the estimate with the third limb (at most twice) */
+        while ((qhat >> LIMB_BITS) != 0 ||
+               qhat * vNext > ((rhat << LIMB_BITS) | window[vLen - 2])) {
+            qhat--;
+            rhat += vTop;
+            if ((rhat >> LIMB_BITS) != 0) {
+                break;
+            }
+        }
+
+        /* Multiply and subtract; add back if the estimate was one too big */
+        borrow = limbsSubMul1(window, v, vLen, (Limb)qhat);
+        if (window[vLen] < borrow) {
+            qhat--;
+            window[vLen] += limbsAdd(window, window, vLen, v, vLen);
+        }
+        window[vLen] -= borrow;
+
+        if (q != NULL) {
+            q[j - 1] = (Limb)qhat;
+        }
+    }
+}
+
+static bool divide2By1(Limb* q, Limb* r, const Limb* a, const Limb* b, size_t n);
+
+/*
+ * Helper: Divide 3k limbs by 2k limbs (Burnikel-Ziegler step)
+ *
+ * Requires a < b * B^k and b normalized. Estimates the quotient from the
+ * top limbs with divide2By1() on the high half of b, then corrects it.
+ * Writes k quotient limbs to q and 2k remainder limbs to r.
+ */
+static bool divide3By2(Limb* q, Limb* r, const Limb* a, const Limb* b, size_t k) {
+    Limb* temp;
+    Limb* t;
+    Limb* d;
+    Limb one = 1;
+    size_t i;
+
+    /* t = [R1 A3] with one extra limb, d = Qhat * B2 */
+    temp = (Limb*)malloc((4 * k + 1) * sizeof(Limb));
+    if (temp == NULL) return false;
+    t = temp;
+    d = temp + 2 * k + 1;
+
+    memcpy(t, a, k * sizeof(Limb));
+    if (limbsCompare(a + 2 * k, k, b + k, k) < 0) {
+        /* Qhat = [A1 A2] / B1, R1 = [A1 A2] % B1 */
+        if (!divide2By1(q, t + k, a + k, b + k, k)) {
+            free(temp);
+            return false;
+        }
+        t[2 * k] = 0;
+    } else {
+        /* A1 == B1: Qhat = B^k - 1 and R1 = A2 + B1 */
+        for (i = 0; i < k; i++) {
+            q[i] = ~(Limb)0;
+        }
+        t[2 * k] = limbsAdd(t + k, a + k, k, b + k, k);
+    }
+
+    if (!limbsMultiply(d, q, k, b, k)) {
+        free(temp);
+        return false;
+    }
+
+    /* Rhat = t - d is off by at most 2 * b; the top limb shows the sign */
+    limbsSub(t, t, 2 * k + 1, d, 2 * k);
+    while (t[2 * k] != 0) {
+        limbsSub(q, q, k, &one, 1);
+        t[2 * k] += limbsAdd(t, t, 2 * k, b, 2 * k);
+    }
+
+    memcpy(r, t, 2 * k * sizeof(Limb));
+    free(temp);
+    return true;
+}
+
+/*
+ * Helper: Divide 2n limbs by n limbs (Burnikel-Ziegler recursion)
+ *
+ * Requires the high half of a to be less than b, and b normalized.
+ * Writes n quotient limbs to q and n remainder limbs to r.
+ */
+static bool divide2By1(Limb* q, Limb* r, const Limb* a, const Limb* b, size_t n) {
+    Limb* temp;
+    size_t k;
+    bool ok;
+
+    /* Base case: Algorithm D on a copy of a */
+    if (n % 2 != 0 || n < BZ_THRESHOLD) {
+        temp = (Limb*)malloc(2 * n * sizeof(Limb));
+        if (temp == NULL) return false;
+        memcpy(temp, a, 2 * n * sizeof(Limb));
+        divideNormalized(q, temp, 2 * n - 1, b, n);
+        memcpy(r, temp, n * sizeof(Limb));
+        free(temp);
+        return true;
+    }
+
+    /* Two 3k-by-2k steps: [A1 A2 A3] / b, then [R A4] / b */
+    k = n / 2;
+    temp = (Limb*)malloc(3 * k * sizeof(Limb));
+    if (temp == NULL) return false;
+
+    ok = divide3By2(q + k, temp + k, a + k, b, k);
+    if (ok) {
+        memcpy(temp, a, k * sizeof(Limb));
+        ok = divide3By2(q, r, temp, b, k);
+    }
+
+    free(temp);
+    return ok;
+}
+
+/*
+ * Helper: Burnikel-Ziegler division for large divisors and quotients
+ *
+ * The divisor is padded at the bottom and shifted so it fills a block of
+ * s = j * 2^k limbs with its top bit set, which lets divide2By1() halve
+ * it cleanly down to the Algorithm D threshold. The dividend gets the
+ * same shift and is divided block by block, schoolbook style.
+ */
+static bool divideRecursive(Limb* q, Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen) {
+    Limb* temp;
+    Limb* v;
+    Limb* u;
+    Limb* quotient;
+    Limb* rem;
+    size_t blockSize, pad, blocks, uLen, qLen, i;
+    unsigned int shift;
+    bool ok;
+
+    /* Smallest block size j * 2^k >= bLen with j below the threshold */
+    blockSize = 1;
+    while (blockSize * BZ_THRESHOLD <= bLen) {
+        blockSize *= 2;
+    }
+    blockSize *= (bLen + blockSize - 1) / blockSize;
+    pad = blockSize - bLen;
+    shift = limbsCountLeadingZeros(b[bLen - 1]);
+
+    /* Room for the shifted dividend plus one spare block */
+    blocks = (aLen + pad + 1 + blockSize - 1) / blockSize + 1;
+    qLen = aLen - bLen + 1;
+
+    temp = (Limb*)malloc((blockSize + blocks * blockSize +
+                          (blocks - 1) * blockSize + blockSize) * sizeof(Limb));
+    if (temp == NULL) return false;
+    v = temp;
+    u = v + blockSize;
+    quotient = u + blocks * blockSize;
+    rem = quotient + (blocks - 1) * blockSize;
+
+    memset(v, 0, pad * sizeof(Limb));
+    limbsShiftLeft(v + pad, b, bLen, shift);
+    memset(u, 0, blocks * blockSize * sizeof(Limb));
+    memset(quotient, 0, (blocks - 1) * blockSize * sizeof(Limb));
+    u[pad + aLen] = limbsShiftLeft(u + pad, a, aLen, shift);
+
+    /* Use as few blocks as possible while keeping the top block below v */
+    uLen = limbsNormalize(u, pad + aLen + 1);
+    blocks = uLen > blockSize ? (uLen + blockSize - 1) / blockSize : 1;
+    if (limbsCompare(u + (blocks - 1) * blockSize,
+                     limbsNormalize(u + (blocks - 1) * blockSize, blockSize),
+                     v, blockSize) >= 0) {
+        blocks++;
+    }
+
+    /* Long division with digits of blockSize limbs */
+    ok = true;
+    for (i = blocks - 1; i > 0 && ok; i--) {
+        Limb* window = u + (i - 1) * blockSize;
+        ok = divide2By1(quotient + (i - 1) * blockSize, rem, window, v, blockSize);
+        memcpy(window, rem, blockSize * sizeof(Limb));
+    }
+
+    if (ok) {
+        if (q != NULL) {
+            memcpy(q, quotient, qLen * sizeof(Limb));
+        }
+        /* Undo padding and shift on the remainder */
+        if (r != NULL) {
+            limbsShiftRight(r, u + pad, bLen, shift);
+        }
+    }
+
+    free(temp);
+    return ok;
+}
+
+/**
+ * @brief Computes q = a / b and r = a % b for natural numbers
+ */
+bool limbsDivRem(Limb* q, Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen) {
+    Limb* temp;
+    Limb* u;
+    Limb* v;
+    unsigned int shift;
+
+    /* Single-limb divisor: one pass, no normalization buffer needed */
+    if (bLen == 1) {
+        Limb rem = limbsDivRem1(q, a, aLen, b[0]);
+        if (r != NULL) {
+            r[0] = rem;
+        }
+        return true;
+    }
+
+    /* Large divisor and quotient: recursive division */
+    if (bLen >= BZ_THRESHOLD && aLen - bLen >= BZ_THRESHOLD) {
+        return divideRecursive(q, r, a, aLen, b, bLen);
+    }
+
+    /* One buffer for the shifted dividend (plus a limb) and divisor */
+    temp = (Limb*)malloc((aLen + 1 + bLen) * sizeof(Limb));
+    if (temp == NULL) return false;
+    u = temp;
+    v = temp + aLen + 1;
+
+    /* Normalize so the divisor's top bit is set */
+    shift = limbsCountLeadingZeros(b[bLen - 1]);
+    limbsShiftLeft(v, b, bLen, shift);
+    u[aLen] = limbsShiftLeft(u, a, aLen, shift);
+
+    divideNormalized(q, u, aLen, v, bLen);
+
+    /* Undo the normalization on the remainder */
+    if (r != NULL) {
+        limbsShiftRight(r, u, bLen, shift);
+    }
+
+    free(temp);
+    return true;
+}
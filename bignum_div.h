@@ -0,0 +1,43 @@
+/**
+ * @file bignum_div.h
+ * @brief Division algorithms for limb arrays
+ *
+ * This module implements long division of limb arrays. Knuth's
+ * Algorithm D handles small divisors and short quotients; above
+ * BZ_THRESHOLD limbs, Burnikel-Ziegler recursive division splits the
+ * work into multiplications, so division runs at the speed of the
+ * subquadratic multipliers in bignum_mul.
+ */
+
+#ifndef BIGNUM_DIV_H
+#define BIGNUM_DIV_H
+
+#include "bignum.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Smallest divisor and quotient size (in limbs) for Burnikel-Ziegler
+ *
+ * Can be overridden at compile time, e.g. -DBZ_THRESHOLD=100.
+ */
+#ifndef BZ_THRESHOLD
+#define BZ_THRESHOLD 80
+#endif
+
+/**
+ * @brief Computes q = a / b and r = a % b for natural numbers
+ *
+ * Requires aLen >= bLen >= 1 and a nonzero top limb in b.
+ *
+ * @param q Quotient array (aLen - bLen + 1 limbs), or NULL if not needed
+ * @param r Remainder array (bLen limbs), or NULL if not needed
+ * @param a Dividend
+ * @param aLen Number of limbs in a
+ * @param b Divisor
+ * @param bLen Number of limbs in b
+ * @return true on success, false if temporary memory could not be allocated
+ */
+bool limbsDivRem(Limb* q, Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen);
+
+#endif /* BIGNUM_DIV_H */
@@ -0,0 +1,339 @@
+/**
+ * @file bignum_limbs.c
+ * @brief Implementation of low-level limb array routines
+ */
+
+#include "bignum_limbs.h"
+#include <string.h>
+
+/**
+ * @brief Returns the length of a limb array without its high zero limbs
+ */
+size_t limbsNormalize(const Limb* a, size_t len) {
+    while (len > 0 && a[len - 1] == 0) {
+        len--;
+    }
+    return len;
+}
+
+/**
+ * @brief Compares two normalized limb arrays
+ */
+int limbsCompare(const Limb* a, size_t aLen, const Limb* b, size_t bLen) {
+    size_t i;
+
+    if (aLen != bLen) {
+        return aLen < bLen ? -1 : 1;
+    }
+
+    /* Same length - compare from the most significant limb down */
+    for (i = aLen; i > 0; i--) {
+        if (a[i - 1] != b[i - 1]) {
+            return a[i - 1] < b[i - 1] ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Computes r = a + b
+ */
+Limb limbsAdd(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen) {
+    DoubleLimb sum;
+    Limb carry;
+    size_t i;
+
+    carry = 0;
+    for (i = 0; i < bLen; i++) {
+        sum = (DoubleLimb)a[i] + b[i] + carry;
+        r[i] = (Limb)sum;
+        carry = (Limb)(sum >> LIMB_BITS);
+    }
+
+    /* Propagate carry through the rest of a */
+    for (; i < aLen; i++) {
+        sum = (DoubleLimb)a[i] + carry;
+        r[i] = (Limb)sum;
+        carry = (Limb)(sum >> LIMB_BITS);
+    }
+
+    return carry;
+}
+
+/**
+ * @brief Computes r = a - b
+ */
+Limb limbsSub(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen) {
+    Limb borrow, ai, bi;
+    size_t i;
+
+    borrow = 0;
+    for (i = 0; i < bLen; i++) {
+        ai = a[i];
+        bi = b[i];
+        r[i] = ai - bi - borrow;
+        borrow = (ai < bi || (ai == bi && borrow)) ? 1 : 0;
+    }
+
+    /* Propagate borrow through the rest of a */
+    for (; i < aLen; i++) {
+        ai = a[i];
+        r[i] = ai - borrow;
+        borrow = (ai < borrow) ? 1 : 0;
+    }
+
+    return borrow;
+}
+
+/**
+ * @brief Computes r = a * m + c for a single-limb multiplier
+ */
+Limb limbsMulAdd1(Limb* r, const Limb* a, size_t len, Limb m, Limb c) {
+    DoubleLimb product;
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        product = (DoubleLimb)a[i] * m + c;
+        r[i] = (Limb)product;
+        c = (Limb)(product >> LIMB_BITS);
+    }
+
+    return c;
+}
+
+/**
+ * @brief Computes r += a * m for a single-limb multiplier
+ */
+Limb limbsAddMul1(Limb* r, const Limb* a, size_t len, Limb m) {
+    DoubleLimb product;
+    Limb carry;
+    size_t i;
+
+    /* a[i] * m + r[i] + carry always fits in a DoubleLimb */
+    carry = 0;
+    for (i = 0; i < len; i++) {
+        product = (DoubleLimb)a[i] * m + r[i] + carry;
+        r[i] = (Limb)product;
+        carry = (Limb)(product >> LIMB_BITS);
+    }
+
+    return carry;
+}
+
+/**
+ * @brief Computes r -= a * m for a single-limb multiplier
+ */
+Limb limbsSubMul1(Limb* r, const Limb* a, size_t len, Limb m) {
+    DoubleLimb product;
+    Limb borrow, low, ri;
+    size_t i;
+
+    borrow = 0;
+    for (i = 0; i < len; i++) {
+        product = (DoubleLimb)a[i] * m + borrow;
+        low = (Limb)product;
+        ri = r[i];
+        r[i] = ri - low;
+        borrow = (Limb)(product >> LIMB_BITS) + (ri < low ? 1 : 0);
+    }
+
+    return borrow;
+}
+
+/**
+ * @brief Shifts a limb array left by fewer than LIMB_BITS bits
+ */
+Limb limbsShiftLeft(Limb* r, const Limb* a, size_t len, unsigned int shift) {
+    Limb out;
+    size_t i;
+
+    if (len == 0) {
+        return 0;
+    }
+    if (shift == 0) {
+        memmove(r, a, len * sizeof(Limb));
+        return 0;
+    }
+
+    /* Work down from the top so r may alias a */
+    out = a[len - 1] >> (LIMB_BITS - shift);
+    for (i = len - 1; i > 0; i--) {
+        r[i] = (a[i] << shift) | (a[i - 1] >> (LIMB_BITS - shift));
+    }
+    r[0] = a[0] << shift;
+
+    return out;
+}
+
+/**
+ * @brief Shifts a limb array right by fewer than LIMB_BITS bits
+ */
+Limb limbsShiftRight(Limb* r, const Limb* a, size_t len, unsigned int shift) {
+    Limb out;
+    size_t i;
+
+    if (len == 0) {
+        return 0;
+    }
+    if (shift == 0) {
+        memmove(r, a, len * sizeof(Limb));
+        return 0;
+    }
+
+    /* Work up from the bottom so r may alias a */
+    out = a[0] << (LIMB_BITS - shift);
+    for (i = 0; i + 1 < len; i++) {
+        r[i] = (a[i] >> shift) | (a[i + 1] << (LIMB_BITS - shift));
+    }
+    r[len - 1] = a[len - 1] >> shift;
+
+    return out;
+}
+
+/**
+ * @brief Counts the leading zero bits of a nonzero limb
+ */
+unsigned int limbsCountLeadingZeros(Limb x) {
+    unsigned int count = 0;
+
+    while (!(x & ((Limb)1 << (LIMB_BITS - 1)))) {
+        x <<= 1;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Divides a limb array by a single nonzero limb
+ *
+ * Uses a precomputed reciprocal of the normalized divisor (Moller and
+ * Granlund, "Improved division by invariant integers"), so each limb
+ * costs two multiplications instead of a hardware division.
+ */
+Limb limbsDivRem1(Limb* q, const Limb* a, size_t len, Limb d) {
+    DoubleLimb product;
+    Limb inverse, rem, next, q0, q1, r;
+    unsigned int shift;
+    size_t i;
+
+    if (len == 0) {
+        return 0;
+    }
+
+    /* Power of two: just shift */
+    if ((d & (d - 1)) == 0) {
+        shift = LIMB_BITS - 1 - limbsCountLeadingZeros(d);
+        rem = a[0] & (d - 1);
+        if (q != NULL) {
+            limbsShiftRight(q, a, len, shift);
+        }
+        return rem;
+    }
+
+    /* Normalize d and compute inverse = floor((B^2 - 1) / d) - B */
+    shift = limbsCountLeadingZeros(d);
+    d <<= shift;
+    inverse = (Limb)((((DoubleLimb)(Limb)~d << LIMB_BITS) | (Limb)~(Limb)0) / d);
+
+    /* Feed the dividend shifted left by the same amount */
+    rem = shift != 0 ? a[len - 1] >> (LIMB_BITS - shift) : 0;
+    for (i = len; i > 0; i--) {
+        next = a[i - 1] << shift;
+        if (shift != 0 && i > 1) {
+            next |= a[i - 2] >> (LIMB_BITS - shift);
+        }
+
+        /* Divide [rem next] by d with the reciprocal */
+        product = (DoubleLimb)inverse * rem + (((DoubleLimb)rem << LIMB_BITS) | next);
+        q1 = (Limb)(product >> LIMB_BITS) + 1;
+        q0 = (Limb)product;
+        r = next - q1 * d;
+        if (r > q0) {
+            q1--;
+            r += d;
+        }
+        if (r >= d) {
+            q1++;
+            r -= d;
+        }
+
+        if (q != NULL) {
+            q[i - 1] = q1;
+        }
+        rem = r;
+    }
+
+    return rem >> shift;
+}
+
+/**
+ * @brief Computes r = a * b with the schoolbook method
+ */
+void limbsMulBasecase(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen) {
+    size_t i;
+
+    memset(r, 0, (aLen + bLen) * sizeof(Limb));
+
+    /* One row of partial products per limb of b */
+    for (i = 0; i < bLen; i++) {
+        r[i + aLen] = limbsAddMul1(r + i, a, aLen, b[i]);
+    }
+}
+
+/**
+ * @brief Computes r = a * a with the schoolbook method
+ */
+void limbsSqrBasecase(Limb* r, const Limb* a, size_t len) {
+    DoubleLimb product, sum;
+    Limb carry;
+    size_t i;
+
+    memset(r, 0, 2 * len * sizeof(Limb));
+    if (len == 0) {
+        return;
+    }
+
+    /* Cross products a[i] * a[j] for i < j, one row per limb */
+    for (i = 0; i + 1 < len; i++) {
+        r[i + len] = limbsAddMul1(r + 2 * i + 1, a + i + 1, len - i - 1, a[i]);
+    }
+
+    /* Double them */
+    for (i = 2 * len - 1; i > 0; i--) {
+        r[i] = (r[i] << 1) | (r[i - 1] >> (LIMB_BITS - 1));
+    }
+    r[0] <<= 1;
+
+    /* Add the squares a[i]^2 on the diagonal */
+    carry = 0;
+    for (i = 0; i < len; i++) {
+        product = (DoubleLimb)a[i] * a[i];
+        sum = (DoubleLimb)r[2 * i] + (Limb)product + carry;
+        r[2 * i] = (Limb)sum;
+        sum = (DoubleLimb)r[2 * i + 1] + (Limb)(product >> LIMB_BITS) + (sum >> LIMB_BITS);
+        r[2 * i + 1] = (Limb)sum;
+        carry = (Limb)(sum >> LIMB_BITS);
+    }
+}
+
+/**
+ * @brief Returns the number of significant bits in a normalized limb array
+ */
+size_t limbsBitLength(const Limb* a, size_t len) {
+    size_t bits;
+    Limb top;
+
+    if (len == 0) {
+        return 0;
+    }
+
+    bits = (len - 1) * LIMB_BITS;
+    top = a[len - 1];
+    while (top != 0) {
+        bits++;
+        top >>= 1;
+    }
+
+    return bits;
+}
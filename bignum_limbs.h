@@ -0,0 +1,143 @@
+/**
+ * @file bignum_limbs.h
+ * @brief Low-level routines on little-endian limb arrays
+ *
+ * This module provides the natural-number kernels that the BigNum
+ * operations are built on. Every routine works on raw arrays of limbs
+ * (least significant limb first) with explicit lengths; none of them
+ * allocate memory or look at signs.
+ */
+
+#ifndef BIGNUM_LIMBS_H
+#define BIGNUM_LIMBS_H
+
+#include "bignum.h"
+#include <stddef.h>
+
+/**
+ * @brief Returns the length of a limb array without its high zero limbs
+ *
+ * @param a Limb array
+ * @param len Number of limbs in a
+ * @return Normalized length (0 if all limbs are zero)
+ */
+size_t limbsNormalize(const Limb* a, size_t len);
+
+/**
+ * @brief Compares two normalized limb arrays
+ *
+ * @param a First array
+ * @param aLen Normalized length of a
+ * @param b Second array
+ * @param bLen Normalized length of b
+ * @return Negative if a < b, zero if a == b, positive if a > b
+ */
+int limbsCompare(const Limb* a, size_t aLen, const Limb* b, size_t bLen);
+
+/**
+ * @brief Computes r = a + b
+ *
+ * Requires aLen >= bLen. Writes aLen limbs to r; r may alias a or b.
+ *
+ * @return Carry out of the top limb (0 or 1)
+ */
+Limb limbsAdd(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen);
+
+/**
+ * @brief Computes r = a - b
+ *
+ * Requires aLen >= bLen. Writes aLen limbs to r; r may alias a or b.
+ *
+ * @return Borrow out of the top limb (0 if a >= b)
+ */
+Limb limbsSub(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen);
+
+/**
+ * @brief Computes r = a * m + c for a single-limb multiplier
+ *
+ * Writes len limbs to r; r may alias a.
+ *
+ * @return High limb of the product
+ */
+Limb limbsMulAdd1(Limb* r, const Limb* a, size_t len, Limb m, Limb c);
+
+/**
+ * @brief Computes r += a * m for a single-limb multiplier
+ *
+ * Updates len limbs of r.
+ *
+ * @return Carry limb to add at r[len]
+ */
+Limb limbsAddMul1(Limb* r, const Limb* a, size_t len, Limb m);
+
+/**
+ * @brief Computes r -= a * m for a single-limb multiplier
+ *
+ * Updates len limbs of r.
+ *
+ * @return Borrow limb to subtract from r[len]
+ */
+Limb limbsSubMul1(Limb* r, const Limb* a, size_t len, Limb m);
+
+/**
+ * @brief Shifts a limb array left by fewer than LIMB_BITS bits
+ *
+ * Writes len limbs to r; r may alias a.
+ *
+ * @return Bits shifted out of the top limb
+ */
+Limb limbsShiftLeft(Limb* r, const Limb* a, size_t len, unsigned int shift);
+
+/**
+ * @brief Shifts a limb array right by fewer than LIMB_BITS bits
+ *
+ * Writes len limbs to r; r may alias a.
+ *
+ * @return Bits shifted out of the bottom limb (in the high bits)
+ */
+Limb limbsShiftRight(Limb* r, const Limb* a, size_t len, unsigned int shift);
+
+/**
+ * @brief Counts the leading zero bits of a nonzero limb
+ *
+ * @param x Limb (must be nonzero)
+ * @return Number of zero bits above the highest set bit
+ */
+unsigned int limbsCountLeadingZeros(Limb x);
+
+/**
+ * @brief Divides a limb array by a single nonzero limb
+ *
+ * A single pass over a with no memory allocation. Writes len quotient
+ * limbs to q; q may alias a or be NULL.
+ *
+ * @return Remainder of the division
+ */
+Limb limbsDivRem1(Limb* q, const Limb* a, size_t len, Limb d);
+
+/**
+ * @brief Computes r = a * b with the schoolbook method
+ *
+ * Writes aLen + bLen limbs to r, which must not overlap a or b.
+ */
+void limbsMulBasecase(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen);
+
+/**
+ * @brief Computes r = a * a with the schoolbook method
+ *
+ * Each cross product a[i] * a[j] is computed once and doubled, so this
+ * does about half the limb multiplications of limbsMulBasecase().
+ * Writes 2 * len limbs to r, which must not overlap a.
+ */
+void limbsSqrBasecase(Limb* r, const Limb* a, size_t len);
+
+/**
+ * @brief Returns the number of significant bits in a normalized limb array
+ *
+ * @param a Limb array
+ * @param len Normalized length of a
+ * @return Bit length (0 for zero)
+ */
+size_t limbsBitLength(const Limb* a, size_t len);
+
+#endif /* BIGNUM_LIMBS_H */
@@ -6,18 +6,173 @@
 #include "bignum_math.h"
 #include "bignum_ops.h"
 #include "bignum.h"
+#include "bignum_limbs.h"
 #include <stdlib.h>
 #include <string.h>
 
+/* Safety limit for power(): about 10 million decimal digits */
+#define POWER_MAX_BITS 33219281UL
+
+/* Largest sliding window used by power() (table of 2^(w-1) odd powers) */
+#define POWER_MAX_WINDOW 3
+
+/* Factors multiplied one limb at a time at the leaves of productTree() */
+#define PRODUCT_TREE_LEAF 16
+
+/* Smallest n for which factorial() uses the prime-swing algorithm */
+#ifndef FACTORIAL_SWING_THRESHOLD
+#define FACTORIAL_SWING_THRESHOLD 1000
+#endif
+
+/* Factorials below this are recomputed instead of cached */
+#define FACTORIAL_CACHE_MIN 256
+
+/* Checkpoints are n with at most this many significant bits (<= 25% apart) */
+#define FACTORIAL_CHECKPOINT_BITS 3
+
+/* Memory budget of the factorial cache: entries and total limbs (16 MB) */
+#define FACTORIAL_CACHE_ENTRIES 32
+#define FACTORIAL_CACHE_LIMBS ((size_t)1 << 22)
+
+/* Levels of cached powers of ten, 10^(9 * 2^k) for k < POWER_CACHE_LEVELS */
+#define POWER_CACHE_LEVELS 32
+
+/* Base of the cached powers: 10^9, the largest power of ten in a limb */
+#define POWER_CACHE_BASE 1000000000
+
+/* A cached checkpoint n! */
+typedef struct {
+    Limb n;
+    BigNum* value;
+    unsigned long lastUse;  /* Clock value of the last hit, for LRU eviction */
+} FactorialCacheEntry;
+
+static FactorialCacheEntry factorialCache[FACTORIAL_CACHE_ENTRIES];
+static size_t factorialCacheCount = 0;
+static size_t factorialCacheLimbs = 0;
+static unsigned long factorialCacheClock = 0;
+
+static BigNum* powerCache[POWER_CACHE_LEVELS];
+static unsigned int powerCacheCount = 0;
+
+/* Helper: Free the odd-power table built by windowedPower() */
+static void destroyPowerTable(BigNum** table, size_t count) {
+    size_t i;
+
+    for (i = 0; i < count; i++) {
+        if (table[i] != NULL) {
+            destroyBigNum(table[i]);
+        }
+    }
+}
+
+/* Helper: Square acc in place, enforcing the size limit */
+static bool squarePower(BigNum* acc) {
+    return squareInPlace(acc) && limbsBitLength(acc->limbs, acc->length) <= POWER_MAX_BITS;
+}
+
+/* Helper: Multiply acc in place by factor, enforcing the size limit */
+static bool mulPower(BigNum* acc, const BigNum* factor) {
+    return mulBy(acc, factor) && limbsBitLength(acc->limbs, acc->length) <= POWER_MAX_BITS;
+}
+
+/*
+ * Helper: Computes |base|^e with left-to-right sliding-window exponentiation
+ *
+ * The exponent is scanned from its top bit. Runs of zero bits cost one
+ * squaring each; every window of up to POWER_MAX_WINDOW bits ending in a
+ * one costs its squarings plus a single multiply by a precomputed odd
+ * power of the base. Returns NULL if the result exceeds POWER_MAX_BITS.
+ */
+static BigNum* windowedPower(const BigNum* base, Limb e) {
+    BigNum* table[1 << (POWER_MAX_WINDOW - 1)];
+    BigNum* result;
+    BigNum* baseSquared;
+    size_t bits, count, i, j;
+    unsigned int window, len;
+    Limb value;
+    bool ok;
+
+    bits = limbsBitLength(&e, 1);
+    window = bits <= 8 ? 1 : (bits <= 24 ? 2 : POWER_MAX_WINDOW);
+    count = (size_t)1 << (window - 1);
+    for (i = 0; i < count; i++) {
+        table[i] = NULL;
+    }
+
+    /* table[i] = |base|^(2i + 1) */
+    table[0] = copyBigNum(base);
+    if (table[0] == NULL) {
+        return NULL;
+    }
+    table[0]->isNegative = false;
+    if (count > 1) {
+        baseSquared = square(table[0]);
+        if (baseSquared == NULL) {
+            destroyPowerTable(table, count);
+            return NULL;
+        }
+        for (i = 1; i < count; i++) {
+            table[i] = multiply(table[i - 1], baseSquared);
+            if (table[i] == NULL) {
+                destroyBigNum(baseSquared);
+                destroyPowerTable(table, count);
+                return NULL;
+            }
+        }
+        destroyBigNum(baseSquared);
+    }
+
+    /* The top bit is set, so the first window initializes the result;
+     * after that every step updates it in place */
+    result = NULL;
+    ok = true;
+    i = bits;
+    while (ok && i > 0) {
+        if (((e >> (i - 1)) & 1) == 0) {
+            ok = squarePower(result);
+            i--;
+            continue;
+        }
+
+        /* Longest window of at most `window` bits that ends in a one */
+        len = window < i ? window : (unsigned int)i;
+        while (((e >> (i - len)) & 1) == 0) {
+            len--;
+        }
+        value = (e >> (i - len)) & (((Limb)1 << len) - 1);
+
+        if (result == NULL) {
+            result = copyBigNum(table[value >> 1]);
+            ok = result != NULL;
+        } else {
+            for (j = 0; j < len && ok; j++) {
+                ok = squarePower(result);
+            }
+            ok = ok && mulPower(result, table[value >> 1]);
+        }
+        i -= len;
+    }
+
+    destroyPowerTable(table, count);
+    if (!ok) {
+        destroyBigNum(result);
+        return NULL;
+    }
+    return result;
+}
+
 /**
  * @brief Raises a BigNum to a power
- * Uses binary exponentiation for efficiency
+ * Uses sliding-window exponentiation, or native arithmetic when the
+ * result fits in a double limb
  */
 BigNum* power(const BigNum* base, const BigNum* exponent) {
-    BigNum *result, *currentBase, *currentExp, *two, *temp, *remainder;
-    BigNum *one, *negOne;
+    BigNum* result;
+    DoubleLimb value;
+    size_t baseBits;
+    Limb e, i;
     bool isOdd;
-    bool baseIsOne, baseIsNegOne;
 
     if (base == NULL || exponent == NULL) {
         return NULL;
@@ -25,7 +180,7 @@ BigNum* power(const BigNum* base, const BigNum* exponent) {
 
     /* Special case: base^0 = 1 (even if base is 0) */
     if (isZero(exponent)) {
-        return createBigNum("1");
+        return copyBigNum(bigNumConstant(1));
     }
 
     /* Special case: 0^n = 0 (for n > 0), undefined for n < 0 */
@@ -37,175 +192,400 @@ BigNum* power(const BigNum* base, const BigNum* exponent) {
         return createBigNumZero();
     }
 
-    /* Handle negative exponents: for integers, base^(-n) = floor(1/base^n) */
+    /* Special case: (+-1)^n is +-1 for any n, including negative n */
+    isOdd = (exponent->limbs[0] & 1) != 0;
+    if (base->length == 1 && base->limbs[0] == 1) {
+        return copyBigNum(bigNumConstant(isNegative(base) && isOdd ? -1 : 1));
+    }
+
+    /* Negative exponents: for |base| > 1, 1/base^n truncates to 0 */
     if (isNegative(exponent)) {
-        /* For integer arithmetic:
-         * - If |base| > 1: result is 0 (since 1/base^n < 1)
-         * - If base == 1: result is 1
-         * - If base == -1: result is -1 (odd exp) or 1 (even exp)
-         */
-        one = createBigNum("1");
-        negOne = createBigNum("-1");
-
-        if (one == NULL || negOne == NULL) {
-            if (one != NULL) destroyBigNum(one);
-            if (negOne != NULL) destroyBigNum(negOne);
+        return createBigNumZero();
+    }
+
+    /* Refuse up front if |base|^exponent must exceed the safety limit:
+     * for |base| >= 2 the result has at least (bits(base) - 1) * exponent bits */
+    baseBits = limbsBitLength(base->limbs, base->length);
+    if (exponent->length > 1 ||
+        (DoubleLimb)(baseBits - 1) * exponent->limbs[0] >= POWER_MAX_BITS) {
+        return NULL;
+    }
+    e = exponent->limbs[0];
+
+    /* Special case: base^1 = base */
+    if (e == 1) {
+        return copyBigNum(base);
+    }
+
+    /* Small results: multiply natively */
+    if ((DoubleLimb)baseBits * e <= 2 * LIMB_BITS) {
+        value = 1;
+        for (i = 0; i < e; i++) {
+            value *= base->limbs[0];
+        }
+        result = createBigNumWithCapacity(2);
+        if (result == NULL) {
             return NULL;
         }
+        result->limbs[0] = (Limb)value;
+        result->limbs[1] = (Limb)(value >> LIMB_BITS);
+        result->length = 2;
+        normalizeBigNum(result);
+        result->isNegative = isNegative(base) && isOdd;
+        return result;
+    }
 
-        baseIsOne = isEqual(base, one);
-        baseIsNegOne = isEqual(base, negOne);
-
-        if (baseIsOne) {
-            destroyBigNum(one);
-            destroyBigNum(negOne);
-            return createBigNum("1");
-        } else if (baseIsNegOne) {
-            /* Check if exponent is odd or even */
-            two = createBigNum("2");
-            if (two == NULL) {
-                destroyBigNum(one);
-                destroyBigNum(negOne);
-                return NULL;
-            }
-
-            /* Use absolute value of exponent for parity check */
-            currentExp = negate(exponent);
-            if (currentExp == NULL) {
-                destroyBigNum(one);
-                destroyBigNum(negOne);
-                destroyBigNum(two);
-                return NULL;
-            }
+    result = windowedPower(base, e);
+    if (result != NULL) {
+        result->isNegative = isNegative(base) && isOdd;
+    }
 
-            remainder = modulo(currentExp, two);
-            destroyBigNum(currentExp);
-            destroyBigNum(two);
+    return result;
+}
 
-            if (remainder == NULL) {
-                destroyBigNum(one);
-                destroyBigNum(negOne);
-                return NULL;
+/*
+ * Helper: Multiplies factors[lo..hi) by balanced binary splitting
+ *
+ * Short ranges are multiplied one limb at a time into an accumulator;
+ * longer ranges are split in half so the large multiplications always
+ * get operands of similar size, where Karatsuba, Toom-3 and the NTT pay
+ * off.
+ */
+static BigNum* productTree(const Limb* factors, size_t lo, size_t hi) {
+    BigNum* result;
+    BigNum* right;
+    Limb carry;
+    size_t i, mid;
+
+    if (hi - lo <= PRODUCT_TREE_LEAF) {
+        result = createBigNumWithCapacity(hi - lo + 1);
+        if (result == NULL) {
+            return NULL;
+        }
+        result->limbs[0] = 1;
+        result->length = 1;
+        for (i = lo; i < hi; i++) {
+            carry = limbsMulAdd1(result->limbs, result->limbs, result->length, factors[i], 0);
+            if (carry != 0) {
+                result->limbs[result->length++] = carry;
             }
+        }
+        return result;
+    }
+
+    /* The left half accumulates the product in place */
+    mid = lo + (hi - lo) / 2;
+    result = productTree(factors, lo, mid);
+    if (result == NULL) {
+        return NULL;
+    }
+    right = productTree(factors, mid, hi);
+    if (right == NULL || !mulBy(result, right)) {
+        destroyBigNum(result);
+        destroyBigNum(right);
+        return NULL;
+    }
+    destroyBigNum(right);
 
-            isOdd = !isZero(remainder);
-            destroyBigNum(remainder);
-            destroyBigNum(one);
-            destroyBigNum(negOne);
+    return result;
+}
 
-            return createBigNum(isOdd ? "-1" : "1");
+/*
+ * Helper: Multiplies count limb-sized factors
+ *
+ * Consecutive factors are first packed in place into partial products
+ * that still fit in a limb, then multiplied with productTree().
+ */
+static BigNum* packedProduct(Limb* factors, size_t count) {
+    Limb current, factor;
+    size_t i, packed;
+
+    packed = 0;
+    current = 1;
+    for (i = 0; i < count; i++) {
+        factor = factors[i];
+        if ((DoubleLimb)current * factor > (Limb)~(Limb)0) {
+            factors[packed++] = current;
+            current = factor;
         } else {
-            /* |base| > 1, so result is 0 */
-            destroyBigNum(one);
-            destroyBigNum(negOne);
-            return createBigNumZero();
+            current *= factor;
         }
     }
+    factors[packed++] = current;
 
-    /* Special case: base^1 = base */
-    {
-        BigNum* one = createBigNum("1");
-        if (one != NULL && isEqual(exponent, one)) {
-            destroyBigNum(one);
-            return copyBigNum(base);
+    return productTree(factors, 0, packed);
+}
+
+/* Helper: Computes lo * (lo + 1) * ... * hi as a product tree (1 if lo > hi) */
+static BigNum* rangeProduct(Limb lo, Limb hi) {
+    BigNum* result;
+    Limb* factors;
+    size_t count;
+    Limb k;
+
+    if (lo > hi) {
+        return copyBigNum(bigNumConstant(1));
+    }
+
+    factors = (Limb*)malloc(((size_t)(hi - lo) + 1) * sizeof(Limb));
+    if (factors == NULL) {
+        return NULL;
+    }
+
+    count = 0;
+    for (k = lo; ; k++) {
+        factors[count++] = k;
+        if (k == hi) {
+            break;
         }
-        if (one != NULL) {
-            destroyBigNum(one);
+    }
+
+    result = packedProduct(factors, count);
+    free(factors);
+
+    return result;
+}
+
+/*
+ * Helper: Computes the swinging factorial n! / ((n/2)!)^2
+ *
+ * Its prime factorization is known in closed form: prime p appears with
+ * exponent sum over k >= 1 of (floor(n / p^k) mod 2), so p^e <= n always
+ * fits in a limb. composite[] must sieve at least up to n.
+ */
+static BigNum* primeSwing(Limb n, const unsigned char* composite) {
+    BigNum* result;
+    Limb* factors;
+    Limb p, q, power;
+    size_t count;
+
+    factors = (Limb*)malloc(((size_t)n / 2 + 1) * sizeof(Limb));
+    if (factors == NULL) {
+        return NULL;
+    }
+
+    count = 0;
+    for (p = 2; p <= n; p++) {
+        if (composite[p]) {
+            continue;
+        }
+
+        /* Collect p^e from the odd quotients n / p^k */
+        power = 1;
+        q = n;
+        while (q >= p) {
+            q /= p;
+            if (q & 1) {
+                power *= p;
+            }
+        }
+        if (power > 1) {
+            factors[count++] = power;
         }
     }
 
-    /* Initialize result to 1 */
-    result = createBigNum("1");
+    result = packedProduct(factors, count);
+    free(factors);
+
+    return result;
+}
+
+/* Helper: Computes n! = ((n/2)!)^2 * swing(n) recursively */
+static BigNum* swingFactorial(Limb n, const unsigned char* composite) {
+    BigNum* result;
+    BigNum* swing;
+
+    if (n < FACTORIAL_SWING_THRESHOLD) {
+        return rangeProduct(2, n);
+    }
+
+    /* (n/2)! becomes n! in place */
+    result = swingFactorial(n / 2, composite);
     if (result == NULL) {
         return NULL;
     }
-
-    /* Copy base and exponent for manipulation */
-    currentBase = copyBigNum(base);
-    if (currentBase == NULL) {
+    if (!squareInPlace(result)) {
         destroyBigNum(result);
         return NULL;
     }
 
-    currentExp = copyBigNum(exponent);
-    if (currentExp == NULL) {
+    swing = primeSwing(n, composite);
+    if (swing == NULL || !mulBy(result, swing)) {
         destroyBigNum(result);
-        destroyBigNum(currentBase);
+        destroyBigNum(swing);
         return NULL;
     }
+    destroyBigNum(swing);
 
-    two = createBigNum("2");
-    if (two == NULL) {
-        destroyBigNum(result);
-        destroyBigNum(currentBase);
-        destroyBigNum(currentExp);
-        return NULL;
+    return result;
+}
+
+/* Helper: Computes n! from scratch, choosing the algorithm by size */
+static BigNum* computeFactorial(Limb n) {
+    BigNum* result;
+    unsigned char* composite;
+    Limb i, j;
+
+    if (n < FACTORIAL_SWING_THRESHOLD) {
+        return rangeProduct(2, n);
     }
 
-    /* Binary exponentiation: base^exp */
-    while (!isZero(currentExp)) {
-        /* Check if exponent is odd (exp % 2 == 1) */
-        remainder = modulo(currentExp, two);
-        isOdd = !isZero(remainder);
-        destroyBigNum(remainder);
-
-        if (isOdd) {
-            /* result *= currentBase */
-            temp = multiply(result, currentBase);
-            destroyBigNum(result);
-            result = temp;
-            if (result == NULL) {
-                destroyBigNum(currentBase);
-                destroyBigNum(currentExp);
-                destroyBigNum(two);
-                return NULL;
-            }
-            /* Safety limit: prevent astronomical results */
-            if (strlen(result->digits) > 10000) {
-                destroyBigNum(result);
-                destroyBigNum(currentBase);
-                destroyBigNum(currentExp);
-                destroyBigNum(two);
-                return NULL;
+    /* Sieve of Eratosthenes up to n, shared by every recursion level */
+    composite = (unsigned char*)calloc((size_t)n + 1, 1);
+    if (composite == NULL) {
+        return NULL;
+    }
+    for (i = 2; i <= n / i; i++) {
+        if (composite[i]) {
+            continue;
+        }
+        for (j = i * i; ; j += i) {
+            composite[j] = 1;
+            if (j > n - i) {
+                break;
             }
         }
+    }
 
-        /* currentBase *= currentBase (square) */
-        temp = multiply(currentBase, currentBase);
-        destroyBigNum(currentBase);
-        currentBase = temp;
-        if (currentBase == NULL) {
-            destroyBigNum(result);
-            destroyBigNum(currentExp);
-            destroyBigNum(two);
-            return NULL;
+    result = swingFactorial(n, composite);
+    free(composite);
+
+    return result;
+}
+
+/* Helper: Rounds n down to a checkpoint (its top FACTORIAL_CHECKPOINT_BITS bits) */
+static Limb factorialCheckpoint(Limb n) {
+    size_t bits = limbsBitLength(&n, 1);
+
+    if (bits <= FACTORIAL_CHECKPOINT_BITS) {
+        return n;
+    }
+    return n & ~(((Limb)1 << (bits - FACTORIAL_CHECKPOINT_BITS)) - 1);
+}
+
+/* Helper: Finds the cached checkpoint with the largest k <= n, or NULL */
+static FactorialCacheEntry* findFactorial(Limb n) {
+    FactorialCacheEntry* best = NULL;
+    size_t i;
+
+    for (i = 0; i < factorialCacheCount; i++) {
+        if (factorialCache[i].n <= n && (best == NULL || factorialCache[i].n > best->n)) {
+            best = &factorialCache[i];
         }
+    }
+    if (best != NULL) {
+        best->lastUse = ++factorialCacheClock;
+    }
+    return best;
+}
+
+/* Helper: Evicts the least recently used checkpoint */
+static void evictFactorial(void) {
+    size_t i, victim;
 
-        /* currentExp /= 2 */
-        temp = divide(currentExp, two);
-        destroyBigNum(currentExp);
-        currentExp = temp;
-        if (currentExp == NULL) {
-            destroyBigNum(result);
-            destroyBigNum(currentBase);
-            destroyBigNum(two);
+    victim = 0;
+    for (i = 1; i < factorialCacheCount; i++) {
+        if (factorialCache[i].lastUse < factorialCache[victim].lastUse) {
+            victim = i;
+        }
+    }
+
+    factorialCacheLimbs -= factorialCache[victim].value->length;
+    destroyBigNum(factorialCache[victim].value);
+    factorialCache[victim] = factorialCache[--factorialCacheCount];
+}
+
+/* Helper: Stores a copy of n! as a checkpoint, evicting old ones to fit */
+static void storeFactorial(Limb n, const BigNum* value) {
+    FactorialCacheEntry* entry;
+    BigNum* copy;
+    Arena* previous;
+
+    /* Too big for the budget even with an empty cache */
+    if (value->length > FACTORIAL_CACHE_LIMBS) {
+        return;
+    }
+
+    while (factorialCacheCount > 0 &&
+           (factorialCacheCount == FACTORIAL_CACHE_ENTRIES ||
+            factorialCacheLimbs + value->length > FACTORIAL_CACHE_LIMBS)) {
+        evictFactorial();
+    }
+
+    /* Checkpoints outlive the evaluation, so they never go in its arena */
+    previous = setBigNumArena(NULL);
+    copy = copyBigNum(value);
+    setBigNumArena(previous);
+    if (copy == NULL) {
+        return;
+    }
+
+    entry = &factorialCache[factorialCacheCount++];
+    entry->n = n;
+    entry->value = copy;
+    entry->lastUse = ++factorialCacheClock;
+    factorialCacheLimbs += copy->length;
+}
+
+/*
+ * Helper: Computes n! through the checkpoint cache
+ *
+ * n is rounded down to a checkpoint m. If m! is not cached it is built
+ * from the nearest cached k! as k! * (k+1)...m when k >= m / 2, or from
+ * scratch otherwise, and then cached. The remaining (m+1)...n is a
+ * short product, since checkpoints are at most 25% apart.
+ */
+static BigNum* cachedFactorial(Limb n) {
+    FactorialCacheEntry* entry;
+    BigNum* checkpoint;
+    BigNum* rest;
+    Limb m;
+
+    m = factorialCheckpoint(n);
+    entry = findFactorial(m);
+
+    if (entry != NULL && entry->n == m) {
+        checkpoint = copyBigNum(entry->value);
+    } else if (entry != NULL && entry->n >= m / 2) {
+        checkpoint = rangeProduct(entry->n + 1, m);
+        if (checkpoint == NULL) {
+            return NULL;
+        }
+        if (!mulBy(checkpoint, entry->value)) {
+            destroyBigNum(checkpoint);
             return NULL;
         }
+        storeFactorial(m, checkpoint);
+    } else {
+        checkpoint = computeFactorial(m);
+        if (checkpoint != NULL) {
+            storeFactorial(m, checkpoint);
+        }
+    }
+
+    if (checkpoint == NULL || m == n) {
+        return checkpoint;
     }
 
-    destroyBigNum(currentBase);
-    destroyBigNum(currentExp);
-    destroyBigNum(two);
+    rest = rangeProduct(m + 1, n);
+    if (rest == NULL || !mulBy(checkpoint, rest)) {
+        destroyBigNum(checkpoint);
+        destroyBigNum(rest);
+        return NULL;
+    }
+    destroyBigNum(rest);
 
-    return result;
+    return checkpoint;
 }
 
 /**
  * @brief Computes factorial of a BigNum
- * Uses iterative multiplication
+ * Small n use a product tree over 2..n; large n use Luschny's
+ * prime-swing algorithm over a sieve of primes up to n, resuming from
+ * cached checkpoints when a nearby factorial was computed before
  */
 BigNum* factorial(const BigNum* n) {
-    BigNum *result, *current, *one, *temp;
+    Limb limit;
 
     if (n == NULL) {
         return NULL;
@@ -216,57 +596,73 @@ BigNum* factorial(const BigNum* n) {
         return NULL;
     }
 
-    /* Special case: 0! = 1 and 1! = 1 */
+    /* Special case: 0! = 1 */
     if (isZero(n)) {
-        return createBigNum("1");
+        return copyBigNum(bigNumConstant(1));
     }
 
-    /* Initialize result to 1 */
-    result = createBigNum("1");
-    if (result == NULL) {
+    /* n! for n beyond one limb could never be stored */
+    if (n->length > 1) {
         return NULL;
     }
+    limit = n->limbs[0];
 
-    /* Create counter starting at 2 */
-    current = createBigNum("2");
-    if (current == NULL) {
-        destroyBigNum(result);
-        return NULL;
+    /* Small factorials are cheaper to recompute than to look up */
+    if (limit < FACTORIAL_CACHE_MIN) {
+        return rangeProduct(2, limit);
     }
 
-    /* Create increment value */
-    one = createBigNum("1");
-    if (one == NULL) {
-        destroyBigNum(result);
-        destroyBigNum(current);
+    return cachedFactorial(limit);
+}
+
+/**
+ * @brief Frees all cached factorial checkpoints
+ */
+void clearFactorialCache(void) {
+    while (factorialCacheCount > 0) {
+        evictFactorial();
+    }
+    factorialCacheClock = 0;
+}
+
+/**
+ * @brief Returns the cached power of ten 10^(9 * 2^k)
+ */
+const BigNum* cachedPowerOfTen(unsigned int k) {
+    BigNum* next;
+    Arena* previous;
+
+    if (k >= POWER_CACHE_LEVELS) {
         return NULL;
     }
 
-    /* Multiply result by each number from 2 to n */
-    while (!isLess(n, current)) {
-        /* result *= current */
-        temp = multiply(result, current);
-        destroyBigNum(result);
-        result = temp;
-        if (result == NULL) {
-            destroyBigNum(current);
-            destroyBigNum(one);
-            return NULL;
+    /* Cached powers outlive the evaluation, so they never go in its arena */
+    previous = setBigNumArena(NULL);
+    while (powerCacheCount <= k) {
+        if (powerCacheCount == 0) {
+            next = createBigNumWithCapacity(1);
+            if (next != NULL) {
+                next->limbs[0] = POWER_CACHE_BASE;
+                next->length = 1;
+            }
+        } else {
+            next = square(powerCache[powerCacheCount - 1]);
         }
-
-        /* current++ */
-        temp = add(current, one);
-        destroyBigNum(current);
-        current = temp;
-        if (current == NULL) {
-            destroyBigNum(result);
-            destroyBigNum(one);
-            return NULL;
+        if (next == NULL) {
+            break;
         }
+        powerCache[powerCacheCount++] = next;
     }
+    setBigNumArena(previous);
 
-    destroyBigNum(current);
-    destroyBigNum(one);
+    return k < powerCacheCount ? powerCache[k] : NULL;
+}
 
-    return result;
+/**
+ * @brief Frees the cached powers of ten
+ */
+void clearPowerCache(void) {
+    while (powerCacheCount > 0) {
+        destroyBigNum(powerCache[--powerCacheCount]);
+    }
 }
@@ -27,11 +27,53 @@ BigNum* power(const BigNum* base, const BigNum* exponent);
  * @brief Computes factorial of a BigNum
  *
  * Computes n! for non-negative integer n.
- * Input must be non-negative.
+ * Input must be non-negative. Results for large n are checkpointed in
+ * a cache (see clearFactorialCache()).
  *
  * @param n Number to compute factorial of (must be non-negative)
  * @return Pointer to newly allocated BigNum containing n!, or NULL on error or negative input
  */
 BigNum* factorial(const BigNum* n);
 
+/** @brief Decimal digits per block at level 0 of cachedPowerOfTen() */
+#define POWER_OF_TEN_DIGITS 9
+
+/**
+ * @brief Crossover (in digits) for divide-and-conquer decimal conversion
+ *
+ * Decimal strings longer than this are split at a 9 * 2^k digit block
+ * when parsed, and longer blocks are halved when printed; shorter ones
+ * use the quadratic chunk loops.
+ */
+#ifndef DECIMAL_SPLIT_DIGITS
+#define DECIMAL_SPLIT_DIGITS 2000
+#endif
+
+/**
+ * @brief Returns the cached power of ten 10^(9 * 2^k)
+ *
+ * The powers are built lazily by repeated squaring and kept until
+ * clearPowerCache(), for splitting numbers at decimal digit boundaries
+ * (a block of 9 * 2^k digits). The result must not be modified or
+ * destroyed.
+ *
+ * @param k Level of the power (at most 31)
+ * @return Pointer to 10^(9 * 2^k), or NULL on error
+ */
+const BigNum* cachedPowerOfTen(unsigned int k);
+
+/**
+ * @brief Frees the cached powers of ten
+ */
+void clearPowerCache(void);
+
+/**
+ * @brief Frees all cached factorial checkpoints
+ *
+ * factorial() keeps n! for checkpoint values of n between calls, within
+ * a fixed memory budget, so nearby factorials can resume from them.
+ * Call this to release that memory, e.g. before exiting.
+ */
+void clearFactorialCache(void);
+
 #endif /* BIGNUM_MATH_H */
@@ -0,0 +1,614 @@
+/**
+ * @file bignum_mul.c
+ * @brief Implementation of schoolbook, Karatsuba, Toom-3 and NTT multiplication
+ */
+
+#include "bignum_mul.h"
+#include "bignum_limbs.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Smallest thresholds for which the recursions still shrink the operands */
+#define MIN_KARATSUBA_THRESHOLD 4
+#define MIN_TOOM3_THRESHOLD 9
+#define MIN_NTT_THRESHOLD 1
+
+/* Multiplicative inverse of 3 modulo 2^32 */
+#define INVERSE_OF_3 0xAAAAAAABu
+
+/*
+ * NTT primes p = c * 2^k + 1 below 2^30, with a primitive root of each.
+ * The product of the three bounds every convolution coefficient of
+ * 16-bit digits, so the exact coefficient follows by CRT. The smallest
+ * 2-adic order (2^23) limits the transform length.
+ */
+#define NTT_PRIME_COUNT 3
+#define NTT_MAX_LOG_LENGTH 23
+#define NTT_DIGIT_BITS 16
+#define NTT_DIGIT_MASK 0xFFFFu
+
+static const Limb NTT_PRIMES[NTT_PRIME_COUNT] = { 998244353u, 167772161u, 469762049u };
+static const Limb NTT_ROOTS[NTT_PRIME_COUNT] = { 3, 3, 3 };
+
+static MultiplyThresholds thresholds = { KARATSUBA_THRESHOLD, TOOM3_THRESHOLD, NTT_THRESHOLD };
+
+static bool karatsubaMultiply(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen);
+static bool toom3Multiply(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen);
+static bool unbalancedMultiply(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen);
+static bool nttFits(size_t aLen, size_t bLen);
+static bool nttMultiply(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen);
+
+/**
+ * @brief Gets the current multiplication crossover points
+ */
+MultiplyThresholds getMultiplyThresholds(void) {
+    return thresholds;
+}
+
+/**
+ * @brief Sets the multiplication crossover points
+ */
+void setMultiplyThresholds(const MultiplyThresholds* newThresholds) {
+    if (newThresholds == NULL) return;
+
+    thresholds = *newThresholds;
+    if (thresholds.karatsuba < MIN_KARATSUBA_THRESHOLD) {
+        thresholds.karatsuba = MIN_KARATSUBA_THRESHOLD;
+    }
+    if (thresholds.toom3 < MIN_TOOM3_THRESHOLD) {
+        thresholds.toom3 = MIN_TOOM3_THRESHOLD;
+    }
+    if (thresholds.ntt < MIN_NTT_THRESHOLD) {
+        thresholds.ntt = MIN_NTT_THRESHOLD;
+    }
+}
+
+/**
+ * @brief Computes r = a * b, picking the algorithm by operand size
+ */
+bool limbsMultiply(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen) {
+    if (a == b && aLen == bLen) {
+        return limbsSquare(r, a, aLen);
+    }
+
+    /* Make a the longer operand */
+    if (aLen < bLen) {
+        const Limb* t = a;
+        size_t tLen = aLen;
+        a = b;
+        aLen = bLen;
+        b = t;
+        bLen = tLen;
+    }
+
+    if (bLen < thresholds.karatsuba) {
+        limbsMulBasecase(r, a, aLen, b, bLen);
+        return true;
+    }
+
+    /* Past the NTT length limit the methods below split the operands */
+    if (bLen >= thresholds.ntt && nttFits(aLen, bLen)) {
+        return nttMultiply(r, a, aLen, b, bLen);
+    }
+
+    /* Karatsuba needs b to reach into the high half of a */
+    if (bLen <= (aLen + 1) / 2) {
+        return unbalancedMultiply(r, a, aLen, b, bLen);
+    }
+
+    /* Toom-3 needs b to reach into the top third of a */
+    if (bLen >= thresholds.toom3 && bLen > 2 * ((aLen + 2) / 3)) {
+        return toom3Multiply(r, a, aLen, b, bLen);
+    }
+
+    return karatsubaMultiply(r, a, aLen, b, bLen);
+}
+
+/**
+ * @brief Computes r = a * a, picking the algorithm by operand size
+ */
+bool limbsSquare(Limb* r, const Limb* a, size_t len) {
+    if (len < thresholds.karatsuba) {
+        limbsSqrBasecase(r, a, len);
+        return true;
+    }
+
+    /* The recursive methods notice a == b and square their pieces */
+    if (len >= thresholds.ntt && nttFits(len, len)) {
+        return nttMultiply(r, a, len, a, len);
+    }
+    if (len >= thresholds.toom3) {
+        return toom3Multiply(r, a, len, a, len);
+    }
+    return karatsubaMultiply(r, a, len, a, len);
+}
+
+/*
+ * Helper: Multiply a long a by a much shorter b (aLen >= 2 * bLen - 1)
+ *
+ * a is cut into pieces of bLen limbs, so every partial product is a
+ * balanced bLen x bLen multiplication that can use the fast algorithms.
+ */
+static bool unbalancedMultiply(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen) {
+    Limb* temp;
+    Limb carry;
+    size_t offset, chunk;
+
+    /* First piece goes straight into r */
+    if (!limbsMultiply(r, a, bLen, b, bLen)) return false;
+
+    temp = (Limb*)malloc(2 * bLen * sizeof(Limb));
+    if (temp == NULL) return false;
+
+    for (offset = bLen; offset < aLen; offset += bLen) {
+        chunk = aLen - offset < bLen ? aLen - offset : bLen;
+
+        if (!limbsMultiply(temp, a + offset, chunk, b, bLen)) {
+            free(temp);
+            return false;
+        }
+
+        /* r holds offset + bLen limbs so far; only the low bLen overlap */
+        carry = limbsAdd(r + offset, r + offset, bLen, temp, bLen);
+        memcpy(r + offset + bLen, temp + bLen, chunk * sizeof(Limb));
+        limbsAdd(r + offset + bLen, r + offset + bLen, chunk, &carry, 1);
+    }
+
+    free(temp);
+    return true;
+}
+
+/*
+ * Helper: Karatsuba multiplication (aLen >= bLen > ceil(aLen / 2))
+ *
+ * With a = a1*B^m + a0 and b = b1*B^m + b0:
+ *   a*b = z2*B^2m + (z1 - z2 - z0)*B^m + z0
+ * where z0 = a0*b0, z2 = a1*b1 and z1 = (a0 + a1)*(b0 + b1).
+ */
+static bool karatsubaMultiply(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen) {
+    Limb* temp;
+    Limb* sumA;
+    Limb* sumB;
+    Limb* middle;
+    size_t m, middleLen;
+    bool ok;
+
+    m = (aLen + 1) / 2;
+
+    /* One block for a0 + a1, b0 + b1 and their product */
+    temp = (Limb*)malloc((4 * m + 4) * sizeof(Limb));
+    if (temp == NULL) return false;
+    sumA = temp;
+    sumB = temp + m + 1;
+    middle = temp + 2 * m + 2;
+
+    sumA[m] = limbsAdd(sumA, a, m, a + m, aLen - m);
+    if (a == b) {
+        sumB = sumA;  /* Squaring: every piece product is a square */
+    } else {
+        sumB[m] = limbsAdd(sumB, b, m, b + m, bLen - m);
+    }
+
+    /* z0 and z2 go directly into the low and high parts of r */
+    ok = limbsMultiply(middle, sumA, m + 1, sumB, m + 1) &&
+         limbsMultiply(r, a, m, b, m) &&
+         limbsMultiply(r + 2 * m, a + m, aLen - m, b + m, bLen - m);
+    if (!ok) {
+        free(temp);
+        return false;
+    }
+
+    /* z1 - z0 - z2 is the middle term a0*b1 + a1*b0 */
+    limbsSub(middle, middle, 2 * m + 2, r, 2 * m);
+    limbsSub(middle, middle, 2 * m + 2, r + 2 * m, aLen + bLen - 2 * m);
+    middleLen = limbsNormalize(middle, 2 * m + 2);
+
+    limbsAdd(r + m, r + m, aLen + bLen - m, middle, middleLen);
+
+    free(temp);
+    return true;
+}
+
+/* Helper: Shift a two's complement limb array right by one bit */
+static void shiftRightSigned1(Limb* a, size_t len) {
+    Limb sign;
+    size_t i;
+
+    sign = a[len - 1] & ((Limb)1 << (LIMB_BITS - 1));
+    for (i = 0; i + 1 < len; i++) {
+        a[i] = (a[i] >> 1) | (a[i + 1] << (LIMB_BITS - 1));
+    }
+    a[len - 1] = (a[len - 1] >> 1) | sign;
+}
+
+/* Helper: Negate a two's complement limb array in place */
+static void negateSigned(Limb* a, size_t len) {
+    Limb one = 1;
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        a[i] = ~a[i];
+    }
+    limbsAdd(a, a, len, &one, 1);
+}
+
+/*
+ * Helper: Divide a limb array by 3, knowing the division is exact
+ *
+ * Works from the low limb up (Hensel division), so it is also correct for
+ * exact multiples of 3 in two's complement.
+ */
+static void divideExactBy3(Limb* a, size_t len) {
+    Limb carry, borrow, s, q;
+    size_t i;
+
+    carry = 0;
+    for (i = 0; i < len; i++) {
+        s = a[i];
+        borrow = (s < carry) ? 1 : 0;
+        s -= carry;
+        q = s * INVERSE_OF_3;
+        a[i] = q;
+        carry = (Limb)(((DoubleLimb)q * 3) >> LIMB_BITS) + borrow;
+    }
+}
+
+/* Helper: Compute r = x0 - x1 + x2 as magnitude and sign (r has k + 1 limbs) */
+static bool evaluateAtMinusOne(Limb* r, const Limb* x0, const Limb* x1,
+                               const Limb* x2, size_t x2Len, size_t k) {
+    size_t sumLen, x1Len;
+
+    r[k] = limbsAdd(r, x0, k, x2, x2Len);
+
+    sumLen = limbsNormalize(r, k + 1);
+    x1Len = limbsNormalize(x1, k);
+    if (limbsCompare(r, sumLen, x1, x1Len) >= 0) {
+        limbsSub(r, r, k + 1, x1, k);
+        return false;
+    }
+
+    /* x0 + x2 < x1, so the sum fits in k limbs */
+    limbsSub(r, x1, k, r, k);
+    r[k] = 0;
+    return true;
+}
+
+/* Helper: Compute p1 = x0 + x1 + x2 and p2 = x0 + 2*x1 + 4*x2 (k + 1 limbs each) */
+static void evaluateAtOneAndTwo(Limb* p1, Limb* p2, const Limb* x0, const Limb* x1,
+                                const Limb* x2, size_t x2Len, size_t k) {
+    p1[k] = limbsAdd(p1, x0, k, x1, k);
+    limbsAdd(p1, p1, k + 1, x2, x2Len);
+
+    /* p2 = 2 * (p1 + x2) - x0 */
+    limbsAdd(p2, p1, k + 1, x2, x2Len);
+    limbsAdd(p2, p2, k + 1, p2, k + 1);
+    limbsSub(p2, p2, k + 1, x0, k);
+}
+
+/*
+ * Helper: Toom-3 multiplication (aLen >= bLen > 2 * ceil(aLen / 3))
+ *
+ * Splits both operands into three pieces of k limbs, evaluates the
+ * piece polynomials at 0, 1, -1, 2 and infinity, multiplies the five
+ * values recursively and interpolates the product coefficients.
+ * Intermediate values can be negative, so interpolation is done in
+ * two's complement on arrays of 2k + 2 limbs.
+ */
+static bool toom3Multiply(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen) {
+    Limb* temp;
+    Limb *pa1, *pb1, *pam1, *pbm1, *pa2, *pb2;
+    Limb *v1, *vm1, *v2;
+    size_t k, width, a2Len, b2Len, totalLen, len;
+    bool negA, negB, ok;
+
+    k = (aLen + 2) / 3;
+    width = 2 * k + 2;
+    a2Len = aLen - 2 * k;
+    b2Len = bLen - 2 * k;
+    totalLen = aLen + bLen;
+
+    /* Six evaluated operands of k + 1 limbs and three products of width limbs */
+    temp = (Limb*)malloc((6 * (k + 1) + 3 * width) * sizeof(Limb));
+    if (temp == NULL) return false;
+    pa1 = temp;
+    pb1 = pa1 + k + 1;
+    pam1 = pb1 + k + 1;
+    pbm1 = pam1 + k + 1;
+    pa2 = pbm1 + k + 1;
+    pb2 = pa2 + k + 1;
+    v1 = pb2 + k + 1;
+    vm1 = v1 + width;
+    v2 = vm1 + width;
+
+    /* Evaluation */
+    evaluateAtOneAndTwo(pa1, pa2, a, a + k, a + 2 * k, a2Len, k);
+    negA = evaluateAtMinusOne(pam1, a, a + k, a + 2 * k, a2Len, k);
+    if (a == b) {
+        /* Squaring: every pointwise product is a square */
+        pb1 = pa1;
+        pb2 = pa2;
+        pbm1 = pam1;
+        negB = negA;
+    } else {
+        evaluateAtOneAndTwo(pb1, pb2, b, b + k, b + 2 * k, b2Len, k);
+        negB = evaluateAtMinusOne(pbm1, b, b + k, b + 2 * k, b2Len, k);
+    }
+
+    /* Pointwise products; r(0) and r(inf) go directly into r */
+    memset(r + 2 * k, 0, 2 * k * sizeof(Limb));
+    ok = limbsMultiply(v1, pa1, k + 1, pb1, k + 1) &&
+         limbsMultiply(vm1, pam1, k + 1, pbm1, k + 1) &&
+         limbsMultiply(v2, pa2, k + 1, pb2, k + 1) &&
+         limbsMultiply(r, a, k, b, k) &&
+         limbsMultiply(r + 4 * k, a + 2 * k, a2Len, b + 2 * k, b2Len);
+    if (!ok) {
+        free(temp);
+        return false;
+    }
+    if (negA != negB) {
+        negateSigned(vm1, width);
+    }
+
+    /* Interpolation; r(0) and r(inf) are the lowest and highest coefficients */
+    limbsSub(v2, v2, width, vm1, width);            /* v2 = (r(2) - r(-1)) / 3 */
+    divideExactBy3(v2, width);
+    limbsSub(vm1, v1, width, vm1, width);           /* vm1 = (r(1) - r(-1)) / 2 */
+    shiftRightSigned1(vm1, width);
+    limbsSub(v1, v1, width, r, 2 * k);              /* v1 = r(1) - r(0) */
+    limbsSub(v2, v2, width, v1, width);             /* v2 = (v2 - v1) / 2 */
+    shiftRightSigned1(v2, width);
+    limbsSub(v1, v1, width, vm1, width);            /* c2 = v1 - vm1 - r(inf) */
+    limbsSub(v1, v1, width, r + 4 * k, a2Len + b2Len);
+    limbsSub(v2, v2, width, r + 4 * k, a2Len + b2Len);  /* c3 = v2 - 2*r(inf) */
+    limbsSub(v2, v2, width, r + 4 * k, a2Len + b2Len);
+    limbsSub(vm1, vm1, width, v2, width);           /* c1 = vm1 - c3 */
+
+    /* Recomposition: the remaining coefficients are non-negative */
+    len = limbsNormalize(vm1, width);
+    limbsAdd(r + k, r + k, totalLen - k, vm1, len);
+    len = limbsNormalize(v1, width);
+    limbsAdd(r + 2 * k, r + 2 * k, totalLen - 2 * k, v1, len);
+    len = limbsNormalize(v2, width);
+    limbsAdd(r + 3 * k, r + 3 * k, totalLen - 3 * k, v2, len);
+
+    free(temp);
+    return true;
+}
+
+/* Helper: Compute -p^(-1) mod 2^32 for an odd modulus p */
+static Limb montgomeryNegInverse(Limb p) {
+    Limb inverse = p;
+    int i;
+
+    /* Newton iteration doubles the number of correct low bits each step */
+    for (i = 0; i < 4; i++) {
+        inverse *= 2 - p * inverse;
+    }
+    return (Limb)0 - inverse;
+}
+
+/* Helper: Montgomery product a * b / 2^32 mod p (p < 2^30, a * b < 2^32 * p) */
+static Limb montgomeryMultiply(Limb a, Limb b, Limb p, Limb negInverse) {
+    DoubleLimb t = (DoubleLimb)a * b;
+    Limb m = (Limb)t * negInverse;
+    Limb u = (Limb)((t + (DoubleLimb)m * p) >> LIMB_BITS);
+
+    return u >= p ? u - p : u;
+}
+
+/* Helper: Compute a * b mod p */
+static Limb multiplyMod(Limb a, Limb b, Limb p) {
+    return (Limb)(((DoubleLimb)a * b) % p);
+}
+
+/* Helper: Compute base^exponent mod p */
+static Limb powerMod(Limb base, Limb exponent, Limb p) {
+    Limb result = 1;
+
+    while (exponent > 0) {
+        if (exponent & 1) {
+            result = multiplyMod(result, base, p);
+        }
+        base = multiplyMod(base, base, p);
+        exponent >>= 1;
+    }
+    return result;
+}
+
+/* Helper: Check whether the product fits in the largest supported transform */
+static bool nttFits(size_t aLen, size_t bLen) {
+    size_t digits = 2 * (aLen + bLen);
+
+    return digits <= ((size_t)1 << NTT_MAX_LOG_LENGTH);
+}
+
+/* Helper: Spread limbs into 16-bit digits, zero-padded to n entries */
+static void splitIntoDigits(Limb* x, size_t n, const Limb* a, size_t aLen) {
+    size_t i;
+
+    for (i = 0; i < aLen; i++) {
+        x[2 * i] = a[i] & NTT_DIGIT_MASK;
+        x[2 * i + 1] = a[i] >> NTT_DIGIT_BITS;
+    }
+    memset(x + 2 * aLen, 0, (n - 2 * aLen) * sizeof(Limb));
+}
+
+/*
+ * Helper: In-place cyclic NTT of length n modulo p
+ *
+ * roots[j] holds w^j * 2^32 mod p (Montgomery form) for j < n / 2, where
+ * w is a primitive n-th root of unity; values in x stay in normal form.
+ */
+static void nttTransform(Limb* x, size_t n, const Limb* roots, Limb p, Limb negInverse) {
+    size_t i, j, k, len, half, step;
+    Limb u, v, t;
+
+    /* Bit-reversal permutation */
+    for (i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            t = x[i];
+            x[i] = x[j];
+            x[j] = t;
+        }
+    }
+
+    /* Cooley-Tukey butterflies */
+    for (len = 2; len <= n; len <<= 1) {
+        half = len / 2;
+        step = n / len;
+        for (i = 0; i < n; i += len) {
+            for (j = 0, k = 0; j < half; j++, k += step) {
+                u = x[i + j];
+                v = montgomeryMultiply(x[i + j + half], roots[k], p, negInverse);
+                x[i + j] = (u + v >= p) ? u + v - p : u + v;
+                x[i + j + half] = (u >= v) ? u - v : u + p - v;
+            }
+        }
+    }
+}
+
+/*
+ * Helper: Cyclic convolution of the digit arrays of a and b modulo p
+ *
+ * Leaves the n convolution coefficients mod p in x; y is scratch.
+ */
+static void nttConvolve(Limb* x, Limb* y, Limb* roots, size_t n,
+                        const Limb* a, size_t aLen, const Limb* b, size_t bLen, int prime) {
+    Limb p, negInverse, w, wMont, r2, scale, t;
+    size_t i;
+
+    p = NTT_PRIMES[prime];
+    negInverse = montgomeryNegInverse(p);
+    r2 = (Limb)(((DoubleLimb)1 << (2 * LIMB_BITS - 2)) % p);
+    r2 = multiplyMod(r2, 4, p);  /* 2^64 mod p */
+
+    /* Twiddle factors in Montgomery form */
+    w = powerMod(NTT_ROOTS[prime], (p - 1) / (Limb)n, p);
+    wMont = montgomeryMultiply(w, r2, p, negInverse);
+    roots[0] = montgomeryMultiply(1, r2, p, negInverse);
+    for (i = 1; i < n / 2; i++) {
+        roots[i] = montgomeryMultiply(roots[i - 1], wMont, p, negInverse);
+    }
+
+    /* Squaring needs only one forward transform */
+    splitIntoDigits(x, n, a, aLen);
+    nttTransform(x, n, roots, p, negInverse);
+    if (a == b) {
+        y = x;
+    } else {
+        splitIntoDigits(y, n, b, bLen);
+        nttTransform(y, n, roots, p, negInverse);
+    }
+
+    /* Pointwise product leaves a factor 2^-32, undone by the final scaling */
+    for (i = 0; i < n; i++) {
+        x[i] = montgomeryMultiply(x[i], y[i], p, negInverse);
+    }
+
+    /* Inverse transform: forward transform, then reverse x[1..n-1] */
+    nttTransform(x, n, roots, p, negInverse);
+    for (i = 1; i < n - i; i++) {
+        t = x[i];
+        x[i] = x[n - i];
+        x[n - i] = t;
+    }
+
+    /* x carries 2^-32 from the pointwise step; scaling by n^-1 * 2^64 fixes both */
+    scale = multiplyMod(powerMod((Limb)(n % p), p - 2, p), r2, p);
+    for (i = 0; i < n; i++) {
+        x[i] = montgomeryMultiply(x[i], scale, p, negInverse);
+    }
+}
+
+/* Helper: Add a 64-bit value into a 3-limb accumulator at limb offset 0 or 1 */
+static void accumulate(Limb* acc, DoubleLimb value, int offset) {
+    DoubleLimb sum;
+
+    sum = (DoubleLimb)acc[offset] + (Limb)value;
+    acc[offset] = (Limb)sum;
+    sum = (DoubleLimb)acc[offset + 1] + (Limb)(value >> LIMB_BITS) + (sum >> LIMB_BITS);
+    acc[offset + 1] = (Limb)sum;
+    if (offset == 0) {
+        acc[2] += (Limb)(sum >> LIMB_BITS);
+    }
+}
+
+/*
+ * Helper: NTT multiplication for operands that fit the transform length
+ *
+ * The operands are split into 16-bit digits and convolved modulo three
+ * primes. Garner's CRT recovers each exact coefficient (below 2^87), and
+ * a 96-bit accumulator carries the coefficients into r.
+ */
+static bool nttMultiply(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen) {
+    Limb* temp;
+    Limb* residues[NTT_PRIME_COUNT];
+    Limb* scratch;
+    Limb* roots;
+    Limb acc[3];
+    Limb p0, p1, p2, inv01, inv012, r0, r1, r2, t1, t2;
+    DoubleLimb p01, low;
+    size_t n, digitCount, i;
+    int j;
+
+    digitCount = 2 * (aLen + bLen);
+    n = 1;
+    while (n < digitCount) {
+        n <<= 1;
+    }
+
+    /* Three residue arrays, one scratch array and the twiddle table */
+    temp = (Limb*)malloc((4 * n + n / 2 + 1) * sizeof(Limb));
+    if (temp == NULL) return false;
+    for (j = 0; j < NTT_PRIME_COUNT; j++) {
+        residues[j] = temp + (size_t)j * n;
+    }
+    scratch = temp + NTT_PRIME_COUNT * n;
+    roots = scratch + n;
+
+    for (j = 0; j < NTT_PRIME_COUNT; j++) {
+        nttConvolve(residues[j], scratch, roots, n, a, aLen, b, bLen, j);
+    }
+
+    /* Garner constants */
+    p0 = NTT_PRIMES[0];
+    p1 = NTT_PRIMES[1];
+    p2 = NTT_PRIMES[2];
+    p01 = (DoubleLimb)p0 * p1;
+    inv01 = powerMod(p0 % p1, p1 - 2, p1);
+    inv012 = powerMod((Limb)(p01 % p2), p2 - 2, p2);
+
+    /* Recombine: x = r0 + p0*t1 + p0*p1*t2, then carry in base 2^16 */
+    acc[0] = acc[1] = acc[2] = 0;
+    for (i = 0; i < digitCount; i++) {
+        r0 = residues[0][i];
+        r1 = residues[1][i];
+        r2 = residues[2][i];
+
+        t1 = multiplyMod((r1 + p1 - r0 % p1) % p1, inv01, p1);
+        low = r0 + (DoubleLimb)p0 * t1;
+        t2 = multiplyMod((Limb)((r2 + p2 - low % p2) % p2), inv012, p2);
+
+        accumulate(acc, low, 0);
+        accumulate(acc, (p01 & 0xFFFFFFFFu) * t2, 0);
+        accumulate(acc, (p01 >> LIMB_BITS) * t2, 1);
+
+        /* Emit 16 bits, shift the accumulator down */
+        if (i % 2 == 0) {
+            r[i / 2] = acc[0] & NTT_DIGIT_MASK;
+        } else {
+            r[i / 2] |= (acc[0] & NTT_DIGIT_MASK) << NTT_DIGIT_BITS;
+        }
+        acc[0] = (acc[0] >> NTT_DIGIT_BITS) | (acc[1] << NTT_DIGIT_BITS);
+        acc[1] = (acc[1] >> NTT_DIGIT_BITS) | (acc[2] << NTT_DIGIT_BITS);
+        acc[2] >>= NTT_DIGIT_BITS;
+    }
+
+    free(temp);
+    return true;
+}
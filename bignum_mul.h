@@ -0,0 +1,99 @@
+/**
+ * @file bignum_mul.h
+ * @brief Multiplication algorithms for limb arrays
+ *
+ * This module chooses between schoolbook, Karatsuba, Toom-3 and
+ * number-theoretic transform (NTT) multiplication based on operand size.
+ * Schoolbook is fastest for small operands; the asymptotically faster
+ * methods take over above crossover points that can be tuned per machine
+ * at runtime. Squaring has its own entry point that follows the same
+ * tiers.
+ */
+
+#ifndef BIGNUM_MUL_H
+#define BIGNUM_MUL_H
+
+#include "bignum.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Default smallest operand size (in limbs) multiplied with Karatsuba
+ *
+ * Can be overridden at compile time, e.g. -DKARATSUBA_THRESHOLD=40.
+ */
+#ifndef KARATSUBA_THRESHOLD
+#define KARATSUBA_THRESHOLD 32
+#endif
+
+/**
+ * @brief Default smallest operand size (in limbs) multiplied with Toom-3
+ */
+#ifndef TOOM3_THRESHOLD
+#define TOOM3_THRESHOLD 160
+#endif
+
+/**
+ * @brief Default smallest operand size (in limbs) multiplied with the NTT
+ */
+#ifndef NTT_THRESHOLD
+#define NTT_THRESHOLD 2500
+#endif
+
+/**
+ * @brief Crossover points between multiplication algorithms
+ *
+ * Each field is the size (in limbs) of the shorter operand from which
+ * the corresponding algorithm is used.
+ */
+typedef struct {
+    size_t karatsuba;  /**< Smallest operand for Karatsuba (minimum 4) */
+    size_t toom3;      /**< Smallest operand for Toom-3 (minimum 9) */
+    size_t ntt;        /**< Smallest operand for the NTT (minimum 1) */
+} MultiplyThresholds;
+
+/**
+ * @brief Gets the current multiplication crossover points
+ *
+ * @return Current thresholds
+ */
+MultiplyThresholds getMultiplyThresholds(void);
+
+/**
+ * @brief Sets the multiplication crossover points
+ *
+ * Values below an algorithm's minimum are raised to that minimum.
+ *
+ * @param thresholds New thresholds
+ */
+void setMultiplyThresholds(const MultiplyThresholds* thresholds);
+
+/**
+ * @brief Computes r = a * b, picking the algorithm by operand size
+ *
+ * Writes aLen + bLen limbs to r, which must not overlap a or b.
+ *
+ * @param r Result array (aLen + bLen limbs)
+ * @param a First operand
+ * @param aLen Number of limbs in a
+ * @param b Second operand
+ * @param bLen Number of limbs in b
+ * @return true on success, false if temporary memory could not be allocated
+ */
+bool limbsMultiply(Limb* r, const Limb* a, size_t aLen, const Limb* b, size_t bLen);
+
+/**
+ * @brief Computes r = a * a, picking the algorithm by operand size
+ *
+ * Uses the same crossover points as limbsMultiply(), with each algorithm
+ * exploiting the symmetry of the operands. limbsMultiply() calls this
+ * automatically when both operands are the same array.
+ *
+ * @param r Result array (2 * len limbs), must not overlap a
+ * @param a Operand
+ * @param len Number of limbs in a
+ * @return true on success, false if temporary memory could not be allocated
+ */
+bool limbsSquare(Limb* r, const Limb* a, size_t len);
+
+#endif /* BIGNUM_MUL_H */
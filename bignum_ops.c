@@ -5,163 +5,165 @@
 
 #include "bignum_ops.h"
 #include "bignum.h"
-#include "utils.h"
+#include "bignum_limbs.h"
+#include "bignum_mul.h"
+#include "bignum_div.h"
 #include <stdlib.h>
 #include <string.h>
 
-/* Helper: Remove leading zeros from a digit string */
-static void removeLeadingZeros(char* digits) {
-    char* p = digits;
-    char* dest;
+/* True if a's magnitude fits in one DoubleLimb (the inline representation) */
+#define IS_SMALL(a) ((a)->length <= BIGNUM_INLINE_LIMBS)
 
-    while (*p == '0' && *(p + 1) != '\0') {
-        p++;
-    }
-
-    if (p != digits) {
-        dest = digits;
-        while (*p != '\0') {
-            *dest++ = *p++;
-        }
-        *dest = '\0';
-    }
+/*
+ * Borrowed view of a BigNum: its magnitude with a sign of our choosing.
+ * Lets subtract() and friends flip a sign without copying the operand.
+ */
+typedef struct {
+    const Limb* limbs;
+    size_t length;
+    bool isNegative;
+} SignedView;
+
+/* Helper: View of a, with its sign flipped if requested (zero stays positive) */
+static SignedView makeView(const BigNum* a, bool flipSign) {
+    SignedView view;
+
+    view.limbs = a->limbs;
+    view.length = a->length;
+    view.isNegative = flipSign ? (!a->isNegative && a->length > 0) : a->isNegative;
+    return view;
 }
 
-/* Helper: Add two unsigned numbers (as digit strings) */
-static char* addUnsigned(const char* a, const char* b) {
-    size_t lenA, lenB, maxLen;
-    char* result;
-    int carry, sum, i, j, k;
+/* Helper: Magnitude of a small limb array as a native integer */
+static DoubleLimb smallMagnitude(const Limb* limbs, size_t length) {
+    DoubleLimb value = 0;
 
-    lenA = strlen(a);
-    lenB = strlen(b);
-    maxLen = (lenA > lenB ? lenA : lenB) + 1;
+    if (length > 1) value = (DoubleLimb)limbs[1] << LIMB_BITS;
+    if (length > 0) value |= limbs[0];
+    return value;
+}
 
-    result = (char*)malloc(maxLen + 1);
-    if (result == NULL) return NULL;
+/* Helper: New BigNum from a native magnitude plus an overflow limb on top */
+static BigNum* createSmall(DoubleLimb magnitude, Limb overflow, bool negative) {
+    BigNum* result;
 
-    carry = 0;
-    i = (int)lenA - 1;
-    j = (int)lenB - 1;
-    k = (int)maxLen - 1;
-    result[k + 1] = '\0';
-
-    while (i >= 0 || j >= 0 || carry) {
-        sum = carry;
-        if (i >= 0) sum += a[i--] - '0';
-        if (j >= 0) sum += b[j--] - '0';
-        result[k--] = (char)((sum % 10) + '0');
-        carry = sum / 10;
-    }
+    /* Only an overflowing result needs more than the inline limbs */
+    result = createBigNumWithCapacity(overflow != 0 ? BIGNUM_INLINE_LIMBS + 1 : BIGNUM_INLINE_LIMBS);
+    if (result == NULL) return NULL;
 
-    /* Shift result to start at position 0 */
-    /* After loop, k is at position before first digit, so digits start at k+1 */
-    if (k >= 0) {
-        memmove(result, result + k + 1, strlen(result + k + 1) + 1);
+    result->limbs[0] = (Limb)magnitude;
+    result->limbs[1] = (Limb)(magnitude >> LIMB_BITS);
+    result->length = 2;
+    if (overflow != 0) {
+        result->limbs[result->length++] = overflow;
     }
 
-    removeLeadingZeros(result);
+    result->isNegative = negative;
+    normalizeBigNum(result);
     return result;
 }
 
-/* Helper: Subtract unsigned b from unsigned a (assumes a >= b) */
-static char* subtractUnsigned(const char* a, const char* b) {
-    size_t lenA, lenB;
-    char* result;
-    int borrow, diff, i, j, k;
+/* Helper: Signed sum of two small values with native arithmetic */
+static BigNum* addSmall(DoubleLimb x, bool xNegative, DoubleLimb y, bool yNegative) {
+    DoubleLimb sum;
 
-    lenA = strlen(a);
-    lenB = strlen(b);
+    /* Same signs: a carry out of the word promotes to three limbs */
+    if (xNegative == yNegative) {
+        sum = x + y;
+        return createSmall(sum, sum < x ? 1 : 0, xNegative);
+    }
 
-    result = (char*)malloc(lenA + 1);
-    if (result == NULL) return NULL;
+    if (x >= y) {
+        return createSmall(x - y, 0, xNegative);
+    }
+    return createSmall(y - x, 0, yNegative);
+}
+
+/* Helper: Add magnitudes of a and b into a new BigNum with the given sign */
+static BigNum* addUnsigned(const SignedView* a, const SignedView* b, bool negative) {
+    BigNum* result;
+    Limb carry;
 
-    borrow = 0;
-    i = (int)lenA - 1;
-    j = (int)lenB - 1;
-    k = (int)lenA - 1;
-    result[lenA] = '\0';
+    /* Make a the longer operand */
+    if (a->length < b->length) {
+        const SignedView* t = a;
+        a = b;
+        b = t;
+    }
 
-    while (i >= 0) {
-        diff = (a[i--] - '0') - borrow;
-        if (j >= 0) diff -= (b[j--] - '0');
+    result = createBigNumWithCapacity(a->length + 1);
+    if (result == NULL) return NULL;
 
-        if (diff < 0) {
-            diff += 10;
-            borrow = 1;
-        } else {
-            borrow = 0;
-        }
-        result[k--] = (char)(diff + '0');
+    carry = limbsAdd(result->limbs, a->limbs, a->length, b->limbs, b->length);
+    result->length = a->length;
+    if (carry != 0) {
+        result->limbs[result->length++] = carry;
     }
 
-    removeLeadingZeros(result);
+    result->isNegative = negative;
+    normalizeBigNum(result);
     return result;
 }
 
-/**
- * @brief Adds two BigNums
- */
-BigNum* add(const BigNum* a, const BigNum* b) {
+/* Helper: Subtract magnitude of b from magnitude of a (assumes |a| >= |b|) */
+static BigNum* subtractUnsigned(const SignedView* a, const SignedView* b, bool negative) {
     BigNum* result;
-    char* digits;
 
-    if (a == NULL || b == NULL) return NULL;
-
-    result = (BigNum*)malloc(sizeof(BigNum));
+    result = createBigNumWithCapacity(a->length);
     if (result == NULL) return NULL;
 
+    limbsSub(result->limbs, a->limbs, a->length, b->limbs, b->length);
+    result->length = a->length;
+
+    result->isNegative = negative;
+    normalizeBigNum(result);
+    return result;
+}
+
+/* Helper: Signed sum of two views: one magnitude add or subtract */
+static BigNum* addViews(const SignedView* a, const SignedView* b) {
+    if (IS_SMALL(a) && IS_SMALL(b)) {
+        return addSmall(smallMagnitude(a->limbs, a->length), a->isNegative,
+                        smallMagnitude(b->limbs, b->length), b->isNegative);
+    }
+
     /* Same signs: add magnitudes, keep sign */
     if (a->isNegative == b->isNegative) {
-        digits = addUnsigned(a->digits, b->digits);
-        if (digits == NULL) {
-            free(result);
-            return NULL;
-        }
-        result->digits = digits;
-        result->isNegative = a->isNegative && strcmp(digits, "0") != 0;
+        return addUnsigned(a, b, a->isNegative);
     }
+
     /* Different signs: subtract smaller from larger */
-    else {
-        if (isLessAbs(a, b)) {
-            digits = subtractUnsigned(b->digits, a->digits);
-            if (digits == NULL) {
-                free(result);
-                return NULL;
-            }
-            result->digits = digits;
-            result->isNegative = b->isNegative && strcmp(digits, "0") != 0;
-        } else {
-            digits = subtractUnsigned(a->digits, b->digits);
-            if (digits == NULL) {
-                free(result);
-                return NULL;
-            }
-            result->digits = digits;
-            result->isNegative = a->isNegative && strcmp(digits, "0") != 0;
-        }
+    if (limbsCompare(a->limbs, a->length, b->limbs, b->length) < 0) {
+        return subtractUnsigned(b, a, b->isNegative);
     }
+    return subtractUnsigned(a, b, a->isNegative);
+}
 
-    return result;
+/**
+ * @brief Adds two BigNums
+ */
+BigNum* add(const BigNum* a, const BigNum* b) {
+    SignedView x, y;
+
+    if (a == NULL || b == NULL) return NULL;
+
+    x = makeView(a, false);
+    y = makeView(b, false);
+    return addViews(&x, &y);
 }
 
 /**
  * @brief Subtracts second BigNum from first
  */
 BigNum* subtract(const BigNum* a, const BigNum* b) {
-    BigNum* negB;
-    BigNum* result;
+    SignedView x, y;
 
     if (a == NULL || b == NULL) return NULL;
 
-    /* a - b = a + (-b) */
-    negB = negate(b);
-    if (negB == NULL) return NULL;
-
-    result = add(a, negB);
-    destroyBigNum(negB);
-
-    return result;
+    /* a - b = a + (-b), with -b as a view rather than a copy */
+    x = makeView(a, false);
+    y = makeView(b, true);
+    return addViews(&x, &y);
 }
 
 /**
@@ -169,10 +171,6 @@ BigNum* subtract(const BigNum* a, const BigNum* b) {
  */
 BigNum* multiply(const BigNum* a, const BigNum* b) {
     BigNum* result;
-    size_t lenA, lenB, lenResult;
-    int* temp;
-    int i, j;
-    char* digits;
 
     if (a == NULL || b == NULL) return NULL;
 
@@ -181,186 +179,216 @@ BigNum* multiply(const BigNum* a, const BigNum* b) {
         return createBigNumZero();
     }
 
-    lenA = strlen(a->digits);
-    lenB = strlen(b->digits);
-    lenResult = lenA + lenB;
-
-    /* Allocate temporary array for multiplication */
-    temp = (int*)calloc(lenResult, sizeof(int));
-    if (temp == NULL) return NULL;
-
-    /* Long multiplication */
-    for (i = (int)lenA - 1; i >= 0; i--) {
-        for (j = (int)lenB - 1; j >= 0; j--) {
-            int product = (a->digits[i] - '0') * (b->digits[j] - '0');
-            int pos = i + j + 1;
+    /* Small operands whose product provably fits a DoubleLimb */
+    if (IS_SMALL(a) && IS_SMALL(b)) {
+        DoubleLimb x = smallMagnitude(a->limbs, a->length);
+        DoubleLimb y = smallMagnitude(b->limbs, b->length);
 
-            temp[pos] += product;
-            temp[pos - 1] += temp[pos] / 10;
-            temp[pos] %= 10;
+        if (a->length + b->length <= BIGNUM_INLINE_LIMBS || x <= (DoubleLimb)~(DoubleLimb)0 / y) {
+            return createSmall(x * y, 0, a->isNegative != b->isNegative);
         }
     }
 
-    /* Convert to string */
-    digits = (char*)malloc(lenResult + 1);
-    if (digits == NULL) {
-        free(temp);
+    result = createBigNumWithCapacity(a->length + b->length);
+    if (result == NULL) return NULL;
+
+    /* limbsMultiply() picks schoolbook, Karatsuba, Toom-3 or NTT by size */
+    if (!limbsMultiply(result->limbs, a->limbs, a->length, b->limbs, b->length)) {
+        destroyBigNum(result);
         return NULL;
     }
+    result->length = a->length + b->length;
+
+    result->isNegative = (a->isNegative != b->isNegative);
+    normalizeBigNum(result);
+
+    return result;
+}
+
+/**
+ * @brief Squares a BigNum
+ */
+BigNum* square(const BigNum* a) {
+    BigNum* result;
 
-    for (i = 0; i < (int)lenResult; i++) {
-        digits[i] = (char)(temp[i] + '0');
+    if (a == NULL) return NULL;
+
+    if (isZero(a)) {
+        return createBigNumZero();
     }
-    digits[lenResult] = '\0';
-    free(temp);
 
-    removeLeadingZeros(digits);
+    result = createBigNumWithCapacity(2 * a->length);
+    if (result == NULL) return NULL;
 
-    result = (BigNum*)malloc(sizeof(BigNum));
-    if (result == NULL) {
-        free(digits);
+    if (!limbsSquare(result->limbs, a->limbs, a->length)) {
+        destroyBigNum(result);
         return NULL;
     }
+    result->length = 2 * a->length;
 
-    result->digits = digits;
-    result->isNegative = (a->isNegative != b->isNegative) && strcmp(digits, "0") != 0;
+    /* A square is never negative */
+    result->isNegative = false;
+    normalizeBigNum(result);
 
     return result;
 }
 
 /**
- * @brief Divides first BigNum by second (integer division)
+ * @brief Divides a BigNum by a single-limb divisor
  */
-BigNum* divide(const BigNum* a, const BigNum* b) {
-    BigNum *quotient, *current, *temp, *one, *absB;
-    char* qDigits;
-    size_t lenA, i, qLen;
-    bool resultNegative;
+BigNum* divideSmall(const BigNum* a, Limb divisor, Limb* remainder) {
+    BigNum* quotient;
+    Limb rem;
 
-    if (a == NULL || b == NULL) return NULL;
+    if (a == NULL || divisor == 0) return NULL;
 
-    /* Division by zero */
-    if (isZero(b)) return NULL;
-
-    /* Dividend is zero */
-    if (isZero(a)) return createBigNumZero();
+    quotient = createBigNumWithCapacity(a->length);
+    if (quotient == NULL) return NULL;
 
-    /* Divisor larger than dividend */
-    if (isLessAbs(a, b)) return createBigNumZero();
+    rem = limbsDivRem1(quotient->limbs, a->limbs, a->length, divisor);
+    quotient->length = a->length;
+    quotient->isNegative = a->isNegative;
+    normalizeBigNum(quotient);
 
-    /* Determine result sign */
-    resultNegative = (a->isNegative != b->isNegative);
+    if (remainder != NULL) {
+        *remainder = rem;
+    }
+    return quotient;
+}
 
-    /* Create absolute value of b for division loop */
-    absB = copyBigNum(b);
-    if (absB == NULL) return NULL;
-    absB->isNegative = false;
+/**
+ * @brief Computes quotient and remainder of two BigNums in one pass
+ */
+bool divmod(const BigNum* a, const BigNum* b, BigNum** quotient, BigNum** remainder) {
+    BigNum* q;
+    BigNum* r;
+    size_t qLen;
 
-    lenA = strlen(a->digits);
-    qDigits = (char*)malloc(lenA + 1);
-    if (qDigits == NULL) {
-        destroyBigNum(absB);
-        return NULL;
-    }
+    if (quotient != NULL) *quotient = NULL;
+    if (remainder != NULL) *remainder = NULL;
 
-    current = createBigNumZero();
-    if (current == NULL) {
-        free(qDigits);
-        destroyBigNum(absB);
-        return NULL;
-    }
+    if (a == NULL || b == NULL) return false;
 
-    one = createBigNum("1");
-    if (one == NULL) {
-        free(qDigits);
-        destroyBigNum(current);
-        destroyBigNum(absB);
-        return NULL;
-    }
+    /* Division by zero */
+    if (isZero(b)) return false;
 
-    qLen = 0;
+    /* Small operands: native division */
+    if (IS_SMALL(a) && IS_SMALL(b)) {
+        DoubleLimb x = smallMagnitude(a->limbs, a->length);
+        DoubleLimb y = smallMagnitude(b->limbs, b->length);
 
-    /* Long division (working with absolute values) */
-    for (i = 0; i < lenA; i++) {
-        char digitStr[2];
-        BigNum* digit;
-        int count;
-
-        /* Bring down next digit */
-        digitStr[0] = a->digits[i];
-        digitStr[1] = '\0';
-        digit = createBigNum(digitStr);
-        if (digit == NULL) {
-            free(qDigits);
-            destroyBigNum(current);
-            destroyBigNum(one);
-            destroyBigNum(absB);
-            return NULL;
+        q = NULL;
+        r = NULL;
+        if (quotient != NULL && (q = createSmall(x / y, 0, a->isNegative != b->isNegative)) == NULL) {
+            return false;
         }
-
-        {
-            BigNum* ten = createBigNum("10");
-            temp = multiply(current, ten);
-            destroyBigNum(ten);
-            destroyBigNum(current);
-            current = add(temp, digit);
-            destroyBigNum(temp);
-            destroyBigNum(digit);
+        if (remainder != NULL && (r = createSmall(x % y, 0, a->isNegative)) == NULL) {
+            if (q != NULL) destroyBigNum(q);
+            return false;
         }
+        if (quotient != NULL) *quotient = q;
+        if (remainder != NULL) *remainder = r;
+        return true;
+    }
 
-        /* Count how many times |b| fits into current */
-        count = 0;
-        while (!isLess(current, absB)) {
-            temp = subtract(current, absB);
-            destroyBigNum(current);
-            current = temp;
-            count++;
+    /* Single-limb divisor: one linear pass with a word remainder */
+    if (b->length == 1) {
+        Limb rem;
+
+        q = NULL;
+        r = NULL;
+        if (quotient != NULL) {
+            q = divideSmall(a, b->limbs[0], &rem);
+            if (q == NULL) return false;
+            if (b->isNegative && !isZero(q)) {
+                q->isNegative = !q->isNegative;
+            }
+        } else {
+            rem = limbsDivRem1(NULL, a->limbs, a->length, b->limbs[0]);
+        }
+        if (remainder != NULL) {
+            r = createBigNumWithCapacity(1);
+            if (r == NULL) {
+                if (q != NULL) destroyBigNum(q);
+                return false;
+            }
+            r->limbs[0] = rem;
+            r->length = 1;
+            r->isNegative = a->isNegative;
+            normalizeBigNum(r);
         }
+        if (quotient != NULL) *quotient = q;
+        if (remainder != NULL) *remainder = r;
+        return true;
+    }
 
-        qDigits[qLen++] = (char)(count + '0');
+    /* Divisor larger than dividend: quotient 0, remainder a */
+    if (isLessAbs(a, b)) {
+        q = NULL;
+        r = NULL;
+        if (quotient != NULL && (q = createBigNumZero()) == NULL) return false;
+        if (remainder != NULL && (r = copyBigNum(a)) == NULL) {
+            if (q != NULL) destroyBigNum(q);
+            return false;
+        }
+        if (quotient != NULL) *quotient = q;
+        if (remainder != NULL) *remainder = r;
+        return true;
     }
 
-    qDigits[qLen] = '\0';
-    destroyBigNum(current);
-    destroyBigNum(one);
-    destroyBigNum(absB);
+    qLen = a->length - b->length + 1;
+    q = NULL;
+    r = NULL;
+    if (quotient != NULL && (q = createBigNumWithCapacity(qLen)) == NULL) return false;
+    if (remainder != NULL && (r = createBigNumWithCapacity(b->length)) == NULL) {
+        if (q != NULL) destroyBigNum(q);
+        return false;
+    }
 
-    removeLeadingZeros(qDigits);
+    /* Long division (working with absolute values) */
+    if (!limbsDivRem(q != NULL ? q->limbs : NULL, r != NULL ? r->limbs : NULL,
+                     a->limbs, a->length, b->limbs, b->length)) {
+        if (q != NULL) destroyBigNum(q);
+        if (r != NULL) destroyBigNum(r);
+        return false;
+    }
 
-    quotient = (BigNum*)malloc(sizeof(BigNum));
-    if (quotient == NULL) {
-        free(qDigits);
-        return NULL;
+    /* Quotient truncates toward zero; remainder takes the dividend's sign */
+    if (q != NULL) {
+        q->length = qLen;
+        q->isNegative = (a->isNegative != b->isNegative);
+        normalizeBigNum(q);
+        *quotient = q;
+    }
+    if (r != NULL) {
+        r->length = b->length;
+        r->isNegative = a->isNegative;
+        normalizeBigNum(r);
+        *remainder = r;
     }
 
-    quotient->digits = qDigits;
-    quotient->isNegative = resultNegative && strcmp(qDigits, "0") != 0;
+    return true;
+}
+
+/**
+ * @brief Divides first BigNum by second (integer division)
+ */
+BigNum* divide(const BigNum* a, const BigNum* b) {
+    BigNum* quotient;
+
+    if (!divmod(a, b, &quotient, NULL)) return NULL;
 
     return quotient;
 }
 
 /**
  * @brief Computes modulo of first BigNum by second
- * Formula: a % m = a - m * floor(a/m) where floor rounds toward zero
+ * The result takes the sign of the dividend, as with C's % operator
  */
 BigNum* modulo(const BigNum* a, const BigNum* b) {
-    BigNum *quotient, *product, *remainder;
-
-    if (a == NULL || b == NULL) return NULL;
+    BigNum* remainder;
 
-    /* Division by zero */
-    if (isZero(b)) return NULL;
-
-    /* a % b = a - b * (a / b) */
-    quotient = divide(a, b);
-    if (quotient == NULL) return NULL;
-
-    product = multiply(b, quotient);
-    destroyBigNum(quotient);
-    if (product == NULL) return NULL;
-
-    remainder = subtract(a, product);
-    destroyBigNum(product);
+    if (!divmod(a, b, NULL, &remainder)) return NULL;
 
     return remainder;
 }
@@ -373,6 +401,7 @@ BigNum* negate(const BigNum* a) {
 
     if (a == NULL) return NULL;
 
+    /* The copy shares a's limbs, so only the sign is written */
     result = copyBigNum(a);
     if (result == NULL) return NULL;
 
@@ -383,3 +412,165 @@ BigNum* negate(const BigNum* a) {
 
     return result;
 }
+
+/* Helper: acc += b, or acc -= b when subtract is set */
+static bool accumulate(BigNum* acc, const BigNum* b, bool subtract) {
+    bool bNegative;
+    Limb carry;
+
+    if (acc == NULL || b == NULL) return false;
+    if (b->length == 0) return true;
+
+    bNegative = makeView(b, subtract).isNegative;
+
+    /* Same signs: add magnitudes in place, keep sign */
+    if (acc->length == 0 || acc->isNegative == bNegative) {
+        const BigNum* longer = acc->length >= b->length ? acc : b;
+        const BigNum* shorter = longer == acc ? b : acc;
+        size_t longLen = longer->length;
+
+        if (!reserveBigNum(acc, longLen + 1)) return false;
+
+        /* limbsAdd() tolerates r aliasing either operand */
+        carry = limbsAdd(acc->limbs, longer->limbs, longLen, shorter->limbs, shorter->length);
+        acc->length = longLen;
+        if (carry != 0) {
+            acc->limbs[acc->length++] = carry;
+        }
+        acc->isNegative = bNegative;
+        return true;
+    }
+
+    /* Different signs: subtract the smaller magnitude from the larger */
+    if (!isLessAbs(acc, b)) {
+        if (!reserveBigNum(acc, acc->length)) return false;
+        limbsSub(acc->limbs, acc->limbs, acc->length, b->limbs, b->length);
+    } else {
+        size_t accLen = acc->length;
+
+        if (!reserveBigNum(acc, b->length)) return false;
+        limbsSub(acc->limbs, b->limbs, b->length, acc->limbs, accLen);
+        acc->length = b->length;
+        acc->isNegative = bNegative;
+    }
+
+    normalizeBigNum(acc);
+    return true;
+}
+
+/**
+ * @brief Adds a BigNum to an accumulator in place
+ */
+bool addTo(BigNum* acc, const BigNum* b) {
+    return accumulate(acc, b, false);
+}
+
+/**
+ * @brief Subtracts a BigNum from an accumulator in place
+ */
+bool subFrom(BigNum* acc, const BigNum* b) {
+    return accumulate(acc, b, true);
+}
+
+/**
+ * @brief Multiplies an accumulator by a BigNum in place
+ */
+bool mulBy(BigNum* acc, const BigNum* b) {
+    BigNum* product;
+    Limb carry;
+
+    if (acc == NULL || b == NULL) return false;
+    if (acc == b) return squareInPlace(acc);
+
+    if (acc->length == 0 || b->length == 0) {
+        acc->length = 0;
+        acc->isNegative = false;
+        return true;
+    }
+
+    /* Single-limb multiplier: one pass over the existing limbs */
+    if (b->length == 1) {
+        if (!reserveBigNum(acc, acc->length + 1)) return false;
+
+        carry = limbsMulAdd1(acc->limbs, acc->limbs, acc->length, b->limbs[0], 0);
+        if (carry != 0) {
+            acc->limbs[acc->length++] = carry;
+        }
+        acc->isNegative = (acc->isNegative != b->isNegative);
+        return true;
+    }
+
+    /* The product needs a separate buffer; swap it in and recycle the old one */
+    product = multiply(acc, b);
+    if (product == NULL) return false;
+
+    swapBigNum(acc, product);
+    destroyBigNum(product);
+    return true;
+}
+
+/**
+ * @brief Squares an accumulator in place
+ */
+bool squareInPlace(BigNum* acc) {
+    BigNum* product;
+
+    if (acc == NULL) return false;
+    if (acc->length == 0) return true;
+
+    product = square(acc);
+    if (product == NULL) return false;
+
+    swapBigNum(acc, product);
+    destroyBigNum(product);
+    return true;
+}
+
+/**
+ * @brief Shifts the magnitude of a BigNum in place
+ */
+bool shiftInPlace(BigNum* num, long bits) {
+    size_t limbShift, len;
+    unsigned int bitShift;
+    Limb out;
+
+    if (num == NULL) return false;
+    if (bits == 0 || num->length == 0) return true;
+
+    len = num->length;
+    if (bits > 0) {
+        limbShift = (size_t)bits / LIMB_BITS;
+        bitShift = (unsigned int)((size_t)bits % LIMB_BITS);
+        if (!reserveBigNum(num, len + limbShift + 1)) return false;
+
+        /* Shift the bits within limbs first, then move whole limbs up */
+        out = limbsShiftLeft(num->limbs, num->limbs, len, bitShift);
+        num->limbs[len] = out;
+        if (limbShift > 0) {
+            memmove(num->limbs + limbShift, num->limbs, (len + 1) * sizeof(Limb));
+            memset(num->limbs, 0, limbShift * sizeof(Limb));
+        }
+        num->length = len + limbShift + 1;
+    } else {
+        /* -(bits + 1) + 1 avoids overflowing on LONG_MIN */
+        limbShift = ((size_t)(-(bits + 1)) + 1) / LIMB_BITS;
+        bitShift = (unsigned int)(((size_t)(-(bits + 1)) + 1) % LIMB_BITS);
+        if (limbShift >= len) {
+            num->length = 0;
+            num->isNegative = false;
+            return true;
+        }
+        if (!reserveBigNum(num, len)) return false;
+
+        /* Drop whole limbs first, then shift the rest within limbs */
+        len -= limbShift;
+        if (limbShift > 0) {
+            memmove(num->limbs, num->limbs + limbShift, len * sizeof(Limb));
+        }
+        limbsShiftRight(num->limbs, num->limbs, len, bitShift);
+        num->length = len;
+    }
+
+    normalizeBigNum(num);
+    return true;
+}
@@ -38,6 +38,17 @@ BigNum* subtract(const BigNum* a, const BigNum* b);
  */
 BigNum* multiply(const BigNum* a, const BigNum* b);
 
+/**
+ * @brief Squares a BigNum
+ *
+ * Faster than multiply(a, a) for large operands because each algorithm
+ * exploits the symmetry of the product.
+ *
+ * @param a Operand
+ * @return Pointer to newly allocated BigNum containing a * a, or NULL on error
+ */
+BigNum* square(const BigNum* a);
+
 /**
  * @brief Divides first BigNum by second (integer division)
  *
@@ -47,6 +58,36 @@ BigNum* multiply(const BigNum* a, const BigNum* b);
  */
 BigNum* divide(const BigNum* a, const BigNum* b);
 
+/**
+ * @brief Divides a BigNum by a single-limb divisor
+ *
+ * A single linear pass over the limbs of a, with no temporary BigNums.
+ * The quotient is truncated toward zero; the remainder of |a| is returned
+ * as a plain limb. divide(), modulo() and divmod() use this path
+ * automatically for single-limb divisors.
+ *
+ * @param a Dividend
+ * @param divisor Nonzero divisor
+ * @param remainder Receives |a| % divisor (may be NULL)
+ * @return Pointer to newly allocated BigNum containing a / divisor, or NULL on error
+ */
+BigNum* divideSmall(const BigNum* a, Limb divisor, Limb* remainder);
+
+/**
+ * @brief Computes quotient and remainder of two BigNums in one pass
+ *
+ * The quotient is truncated toward zero and the remainder takes the sign
+ * of the dividend, so a == b * quotient + remainder. Either output may be
+ * NULL when only the other one is needed.
+ *
+ * @param a Dividend
+ * @param b Divisor
+ * @param quotient Receives newly allocated a / b (may be NULL)
+ * @param remainder Receives newly allocated a % b (may be NULL)
+ * @return true on success, false on error or division by zero
+ */
+bool divmod(const BigNum* a, const BigNum* b, BigNum** quotient, BigNum** remainder);
+
 /**
  * @brief Computes modulo of first BigNum by second
  *
@@ -64,4 +105,64 @@ BigNum* modulo(const BigNum* a, const BigNum* b);
  */
 BigNum* negate(const BigNum* a);
 
+/*
+ * In-place arithmetic
+ *
+ * These update an existing BigNum instead of returning a new one. The
+ * limb array is reused when it is large enough and not shared with a
+ * copy; otherwise reserveBigNum() replaces it, so accumulating loops
+ * allocate rarely and copies of the old value are left untouched.
+ */
+
+/**
+ * @brief Adds a BigNum to an accumulator in place
+ *
+ * @param acc Accumulator, receives acc + b
+ * @param b Operand (may be acc itself)
+ * @return true on success, false on error
+ */
+bool addTo(BigNum* acc, const BigNum* b);
+
+/**
+ * @brief Subtracts a BigNum from an accumulator in place
+ *
+ * @param acc Accumulator, receives acc - b
+ * @param b Operand (may be acc itself)
+ * @return true on success, false on error
+ */
+bool subFrom(BigNum* acc, const BigNum* b);
+
+/**
+ * @brief Multiplies an accumulator by a BigNum in place
+ *
+ * Single-limb multipliers work directly on the accumulator's limbs;
+ * longer ones build the product in a new array and recycle the old one.
+ *
+ * @param acc Accumulator, receives acc * b
+ * @param b Operand (may be acc itself)
+ * @return true on success, false on error
+ */
+bool mulBy(BigNum* acc, const BigNum* b);
+
+/**
+ * @brief Squares an accumulator in place
+ *
+ * @param acc Accumulator, receives acc * acc
+ * @return true on success, false on error
+ */
+bool squareInPlace(BigNum* acc);
+
+/**
+ * @brief Shifts the magnitude of a BigNum in place
+ *
+ * A positive count shifts left (multiplies |num| by 2^bits), a negative
+ * count shifts right, truncating the magnitude. The sign is kept unless
+ * the result is zero.
+ *
+ * @param num BigNum to shift
+ * @param bits Number of bit positions, positive for left
+ * @return true on success, false on error
+ */
+bool shiftInPlace(BigNum* num, long bits);
+
 #endif /* BIGNUM_OPS_H */
@@ -8,6 +8,7 @@
 #include "parser.h"
 #include "evaluator.h"
 #include "formatter.h"
+#include "bignum_math.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -87,6 +88,11 @@ CalculatorState* initCalculator(void) {
     if (state == NULL) return NULL;
 
     state->mode = MODE_DECIMAL;  /* Default to decimal mode */
+    state->arena = createArena(ARENA_BLOCK_SIZE);
+    if (state->arena == NULL) {
+        free(state);
+        return NULL;
+    }
     return state;
 }
 
@@ -94,6 +100,13 @@ CalculatorState* initCalculator(void) {
  * @brief Frees calculator state
  */
 void destroyCalculator(CalculatorState* state) {
+    /* Caches and pooled BigNums live for the whole session */
+    clearFactorialCache();
+    clearPowerCache();
+    clearBigNumPool();
+    if (state != NULL) {
+        destroyArena(state->arena);
+    }
     free(state);
 }
 
@@ -168,22 +181,23 @@ bool processInput(CalculatorState* state, const char* input) {
     }
 
     /* Otherwise, treat as expression */
-    /* Parse expression to postfix */
-    postfix = infixToPostfix(trimmed);
+    /* Parse expression to postfix (tokens and temporaries live in the arena) */
+    postfix = infixToPostfix(trimmed, state->arena);
     if (postfix == NULL) {
         printf("Syntax error!\n");
+        resetArena(state->arena);
         free(inputCopy);
         return true;
     }
 
     /* Evaluate postfix expression */
-    result = evaluatePostfix(postfix);
-    freeTokens(postfix);
+    result = evaluatePostfix(postfix, state->arena);
 
     /* Check for evaluation errors */
     if (result.error != EVAL_SUCCESS) {
         printf("%s\n", getEvaluationErrorMessage(result.error));
         freeEvalResult(&result);
+        resetArena(state->arena);
         free(inputCopy);
         return true;
     }
@@ -209,7 +223,9 @@ bool processInput(CalculatorState* state, const char* input) {
         printf("Memory allocation error!\n");
     }
 
+    /* The result is printed, so the whole evaluation can go at once */
     freeEvalResult(&result);
+    resetArena(state->arena);
     free(inputCopy);
     return true;
 }
@@ -10,6 +10,7 @@
 #ifndef CALCULATOR_H
 #define CALCULATOR_H
 
+#include "arena.h"
 #include <stdbool.h>
 
 /**
@@ -26,6 +27,7 @@ typedef enum {
  */
 typedef struct {
     OutputMode mode;   /**< Current output mode */
+    Arena* arena;      /**< Scratch memory for one expression, reset after each */
 } CalculatorState;
 
 /**
@@ -5,6 +5,7 @@
 
 #include "converter.h"
 #include "bignum_ops.h"
+#include "bignum_math.h"
 #include "utils.h"
 #include <stdlib.h>
 #include <string.h>
@@ -18,64 +19,155 @@ static int hexCharToValue(char c) {
     return -1;
 }
 
-/* Helper: Convert binary string to decimal (positive only) */
-static BigNum* binaryToDecimal(const char* binary) {
+/* Helper: Convert binary character to value */
+static int binaryCharToValue(char c) {
+    if (c == '0' || c == '1') return c - '0';
+    return -1;
+}
+
+/*
+ * Helper: Packs a string of binary or hex digits into limbs
+ *
+ * Each digit holds bitsPerDigit bits (1 or 4, both dividing LIMB_BITS),
+ * so digits are OR-ed into their limb from the least significant end in
+ * a single pass. The digits are read as an unsigned number; *topBitSet
+ * receives the most significant bit of the first digit, the two's
+ * complement sign. Returns NULL on an invalid digit.
+ */
+static BigNum* packDigits(const char* digits, size_t count, unsigned int bitsPerDigit,
+                          bool* topBitSet) {
     BigNum* result;
-    BigNum* two;
-    BigNum* temp;
-    const char* p;
+    size_t limbCount, bit, i;
+    int value;
 
-    result = createBigNumZero();
+    limbCount = (count * bitsPerDigit + LIMB_BITS - 1) / LIMB_BITS;
+    result = createBigNumWithCapacity(limbCount);
     if (result == NULL) return NULL;
 
-    two = createBigNum("2");
-    if (two == NULL) {
-        destroyBigNum(result);
-        return NULL;
-    }
+    memset(result->limbs, 0, limbCount * sizeof(Limb));
+    result->length = limbCount;
 
-    /* Process each bit */
-    for (p = binary; *p != '\0'; p++) {
-        /* result = result * 2 */
-        temp = multiply(result, two);
-        destroyBigNum(result);
-        if (temp == NULL) {
-            destroyBigNum(two);
-            return NULL;
-        }
-        result = temp;
-
-        /* If bit is 1, add 1 */
-        if (*p == '1') {
-            BigNum* one = createBigNum("1");
-            if (one == NULL) {
-                destroyBigNum(result);
-                destroyBigNum(two);
-                return NULL;
-            }
-            temp = add(result, one);
-            destroyBigNum(one);
+    bit = 0;
+    value = 0;
+    for (i = count; i > 0; i--, bit += bitsPerDigit) {
+        value = bitsPerDigit == 1 ? binaryCharToValue(digits[i - 1]) : hexCharToValue(digits[i - 1]);
+        if (value < 0) {
             destroyBigNum(result);
-            if (temp == NULL) {
-                destroyBigNum(two);
-                return NULL;
-            }
-            result = temp;
+            return NULL;
         }
+        result->limbs[bit / LIMB_BITS] |= (Limb)value << (bit % LIMB_BITS);
+    }
+
+    /* value now holds the first (most significant) digit */
+    *topBitSet = ((unsigned int)value >> (bitsPerDigit - 1)) != 0;
+
+    normalizeBigNum(result);
+    return result;
+}
+
+/*
+ * Helper: Parses the digits of a 0b/0x literal as an n-bit two's
+ * complement number
+ *
+ * The digits are packed as an unsigned value; if the top bit is set
+ * the result is value - 2^n, computed with one subtraction.
+ */
+static BigNum* parseTwosComplement(const char* digits, unsigned int bitsPerDigit) {
+    BigNum* result;
+    BigNum* weight;
+    size_t count;
+    bool topBitSet;
+
+    /* Empty after prefix */
+    count = strlen(digits);
+    if (count == 0) return NULL;
+
+    result = packDigits(digits, count, bitsPerDigit, &topBitSet);
+    if (result == NULL || !topBitSet) return result;
+
+    /* Negative: subtract the weight 2^n of the whole literal */
+    weight = copyBigNum(bigNumConstant(1));
+    if (weight == NULL || !shiftInPlace(weight, (long)(count * bitsPerDigit)) ||
+        !subFrom(result, weight)) {
+        destroyBigNum(weight);
+        destroyBigNum(result);
+        return NULL;
     }
+    destroyBigNum(weight);
 
-    destroyBigNum(two);
     return result;
 }
 
+/*
+ * Helper: Converts len decimal digits by divide and conquer
+ *
+ * The low block of 9 * 2^k digits (the largest such block shorter than
+ * len) and the high part are converted recursively and combined as
+ * hi * 10^(9 * 2^k) + lo, with the power taken from the cache. With a
+ * subquadratic multiplier this beats the digit-chunk loop of
+ * createBigNumFromDigits() on long literals.
+ */
+static BigNum* parseDecimalDigits(const char* digits, size_t len) {
+    BigNum* hi;
+    BigNum* lo;
+    const BigNum* scale;
+    size_t loLen;
+    unsigned int k;
+
+    if (len <= DECIMAL_SPLIT_DIGITS) {
+        return createBigNumFromDigits(digits, len);
+    }
+
+    k = 0;
+    while (((size_t)POWER_OF_TEN_DIGITS << (k + 1)) < len) {
+        k++;
+    }
+    loLen = (size_t)POWER_OF_TEN_DIGITS << k;
+
+    scale = cachedPowerOfTen(k);
+    if (scale == NULL) return NULL;
+
+    hi = parseDecimalDigits(digits, len - loLen);
+    if (hi == NULL) return NULL;
+    lo = parseDecimalDigits(digits + len - loLen, loLen);
+    if (lo == NULL || !mulBy(hi, scale) || !addTo(hi, lo)) {
+        destroyBigNum(hi);
+        destroyBigNum(lo);
+        return NULL;
+    }
+    destroyBigNum(lo);
+
+    return hi;
+}
+
 /**
  * @brief Parses a decimal string to BigNum
  */
 BigNum* parseDecimal(const char* str) {
+    const char* digits;
+    BigNum* result;
+    size_t len;
+
     if (str == NULL) return NULL;
 
-    /* Decimal parsing is handled directly by createBigNum */
-    return createBigNum(str);
+    /* Short literals are handled directly by createBigNum */
+    len = strlen(str);
+    if (len <= DECIMAL_SPLIT_DIGITS) {
+        return createBigNum(str);
+    }
+
+    if (!isValidDecimal(str)) return NULL;
+
+    digits = str;
+    if (*digits == '-' || *digits == '+') {
+        digits++;
+    }
+
+    result = parseDecimalDigits(digits, strlen(digits));
+    if (result != NULL && str[0] == '-' && !isZero(result)) {
+        result->isNegative = true;
+    }
+    return result;
 }
 
 /**
@@ -91,9 +183,6 @@ BigNum* parseDecimal(const char* str) {
  * - 0b1111 = -1 (MSB=1, two's complement: -8+4+2+1=-1)
  */
 BigNum* parseBinary(const char* str) {
-    const char* digits;
-    size_t numBits;
-
     if (str == NULL || strlen(str) < 3) return NULL;
 
     /* Check for "0b" prefix */
@@ -101,68 +190,8 @@ BigNum* parseBinary(const char* str) {
         return NULL;
     }
 
-    digits = str + 2;  /* Skip "0b" */
-
-    /* Empty after prefix */
-    if (*digits == '\0') return NULL;
-
-    numBits = strlen(digits);
-
-    /* Check MSB for two's complement sign */
-    if (digits[0] == '1') {
-        /* MSB is 1: negative number in two's complement
-         * Value = (lower bits as unsigned) - (2^(n-1))
-         * where n is the total number of bits
-         */
-        BigNum* lowerBits;
-        BigNum* msbWeight;
-        BigNum* two;
-        BigNum* result;
-        size_t i;
-
-        /* Calculate MSB weight = 2^(numBits-1) */
-        two = createBigNum("2");
-        if (two == NULL) return NULL;
-
-        msbWeight = createBigNum("1");
-        if (msbWeight == NULL) {
-            destroyBigNum(two);
-            return NULL;
-        }
-
-        for (i = 1; i < numBits; i++) {
-            BigNum* temp = multiply(msbWeight, two);
-            destroyBigNum(msbWeight);
-            if (temp == NULL) {
-                destroyBigNum(two);
-                return NULL;
-            }
-            msbWeight = temp;
-        }
-        destroyBigNum(two);
-
-        /* Parse lower bits (all except MSB) as unsigned */
-        if (numBits == 1) {
-            /* Single bit '1' = -1 */
-            lowerBits = createBigNumZero();
-        } else {
-            lowerBits = binaryToDecimal(digits + 1);
-        }
-        if (lowerBits == NULL) {
-            destroyBigNum(msbWeight);
-            return NULL;
-        }
-
-        /* Result = lowerBits - msbWeight (negative result) */
-        result = subtract(lowerBits, msbWeight);
-        destroyBigNum(lowerBits);
-        destroyBigNum(msbWeight);
-
-        return result;
-    } else {
-        /* MSB is 0: positive number, parse as unsigned */
-        return binaryToDecimal(digits);
-    }
+    /* n bits: value = (bits as unsigned) - (MSB ? 2^n : 0) */
+    return parseTwosComplement(str + 2, 1);
 }
 
 /**
@@ -178,13 +207,6 @@ BigNum* parseBinary(const char* str) {
  * - 0xa = -6 (first digit=10 >= 8, two's complement: 2-8=-6)
  */
 BigNum* parseHexadecimal(const char* str) {
-    const char* digits;
-    char* binary;
-    size_t hexLen;
-    size_t binLen;
-    size_t i;
-    BigNum* result;
-
     if (str == NULL || strlen(str) < 3) return NULL;
 
     /* Check for "0x" prefix */
@@ -192,52 +214,8 @@ BigNum* parseHexadecimal(const char* str) {
         return NULL;
     }
 
-    digits = str + 2;  /* Skip "0x" */
-
-    /* Empty after prefix */
-    if (*digits == '\0') return NULL;
-
-    hexLen = strlen(digits);
-    binLen = hexLen * 4;  /* Each hex digit = 4 binary bits */
-
-    /* Allocate binary string */
-    binary = (char*)malloc(binLen + 1);
-    if (binary == NULL) return NULL;
-
-    /* Convert hex to binary (4 bits per hex digit) */
-    for (i = 0; i < hexLen; i++) {
-        int val = hexCharToValue(digits[i]);
-        if (val < 0) {
-            free(binary);
-            return NULL;
-        }
-
-        /* Convert to 4 binary digits */
-        binary[i * 4 + 0] = (val & 8) ? '1' : '0';
-        binary[i * 4 + 1] = (val & 4) ? '1' : '0';
-        binary[i * 4 + 2] = (val & 2) ? '1' : '0';
-        binary[i * 4 + 3] = (val & 1) ? '1' : '0';
-    }
-    binary[binLen] = '\0';
-
-    /* Use parseBinary which handles two's complement */
-    /* Need to add "0b" prefix for parseBinary */
-    {
-        char* binaryWithPrefix = (char*)malloc(binLen + 3);
-        if (binaryWithPrefix == NULL) {
-            free(binary);
-            return NULL;
-        }
-        binaryWithPrefix[0] = '0';
-        binaryWithPrefix[1] = 'b';
-        strcpy(binaryWithPrefix + 2, binary);
-        free(binary);
-
-        result = parseBinary(binaryWithPrefix);
-        free(binaryWithPrefix);
-    }
-
-    return result;
+    /* Each hex digit is 4 bits; the MSB of the first digit is the sign */
+    return parseTwosComplement(str + 2, 4);
 }
 
 /**
@@ -245,6 +223,7 @@ BigNum* parseHexadecimal(const char* str) {
  */
 bool isValidDecimal(const char* str) {
     const char* p;
+    size_t len;
 
     if (str == NULL || *str == '\0') return false;
 
@@ -259,12 +238,8 @@ bool isValidDecimal(const char* str) {
     if (*p == '\0') return false;
 
     /* Check all remaining characters are digits */
-    while (*p != '\0') {
-        if (!isDigitChar(*p)) return false;
-        p++;
-    }
-
-    return true;
+    len = strlen(p);
+    return spanDecimalDigits(p, len) == len;
 }
 
 /**
@@ -272,6 +247,7 @@ bool isValidDecimal(const char* str) {
  */
 bool isValidBinary(const char* str) {
     const char* p;
+    size_t len;
 
     if (str == NULL || strlen(str) < 3) return false;
 
@@ -286,12 +262,8 @@ bool isValidBinary(const char* str) {
     if (*p == '\0') return false;
 
     /* Check all remaining characters are 0 or 1 */
-    while (*p != '\0') {
-        if (*p != '0' && *p != '1') return false;
-        p++;
-    }
-
-    return true;
+    len = strlen(p);
+    return spanBinaryDigits(p, len) == len;
 }
 
 /**
@@ -299,6 +271,7 @@ bool isValidBinary(const char* str) {
  */
 bool isValidHexadecimal(const char* str) {
     const char* p;
+    size_t len;
 
     if (str == NULL || strlen(str) < 3) return false;
 
@@ -313,10 +286,6 @@ bool isValidHexadecimal(const char* str) {
     if (*p == '\0') return false;
 
     /* Check all remaining characters are hex digits */
-    while (*p != '\0') {
-        if (!isHexDigitChar(*p)) return false;
-        p++;
-    }
-
-    return true;
+    len = strlen(p);
+    return spanHexDigits(p, len) == len;
 }
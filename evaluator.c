@@ -15,21 +15,25 @@ typedef struct {
     BigNum** items;
     int top;
     int capacity;
+    Arena* arena;
 } BigNumStack;
 
-/* Helper: Create BigNum stack */
-static BigNumStack* createBigNumStack(int capacity) {
-    BigNumStack* stack = (BigNumStack*)malloc(sizeof(BigNumStack));
+/* Helper: Create BigNum stack (in the arena if one is given) */
+static BigNumStack* createBigNumStack(int capacity, Arena* arena) {
+    BigNumStack* stack;
+
+    stack = (BigNumStack*)arenaOrHeapAlloc(arena, sizeof(BigNumStack));
     if (stack == NULL) return NULL;
 
-    stack->items = (BigNum**)malloc(capacity * sizeof(BigNum*));
+    stack->items = (BigNum**)arenaOrHeapAlloc(arena, capacity * sizeof(BigNum*));
     if (stack->items == NULL) {
-        free(stack);
+        arenaOrHeapFree(arena, stack);
         return NULL;
     }
 
     stack->top = -1;
     stack->capacity = capacity;
+    stack->arena = arena;
     return stack;
 }
 
@@ -42,15 +46,17 @@ static void destroyBigNumStack(BigNumStack* stack) {
         for (i = 0; i <= stack->top; i++) {
             destroyBigNum(stack->items[i]);
         }
-        free(stack->items);
-        free(stack);
+        arenaOrHeapFree(stack->arena, stack->items);
+        arenaOrHeapFree(stack->arena, stack);
     }
 }
 
 /* Helper: Push to BigNum stack */
 static bool pushBigNum(BigNumStack* stack, BigNum* num) {
     if (stack->top >= stack->capacity - 1) {
-        BigNum** newItems = (BigNum**)realloc(stack->items, stack->capacity * 2 * sizeof(BigNum*));
+        BigNum** newItems = (BigNum**)arenaOrHeapGrow(stack->arena, stack->items,
+                                                      stack->capacity * sizeof(BigNum*),
+                                                      stack->capacity * 2 * sizeof(BigNum*));
         if (newItems == NULL) return false;
         stack->items = newItems;
         stack->capacity *= 2;
@@ -70,10 +76,8 @@ static bool isBigNumStackEmpty(BigNumStack* stack) {
     return stack->top < 0;
 }
 
-/**
- * @brief Evaluates a postfix expression
- */
-EvalResult evaluatePostfix(Token* tokens) {
+/* Helper: Evaluates a postfix expression with BigNums in the current arena */
+static EvalResult evaluateTokens(Token* tokens, Arena* arena) {
     EvalResult evalResult;
     BigNumStack* stack;
     int i;
@@ -87,7 +91,7 @@ EvalResult evaluatePostfix(Token* tokens) {
     }
 
     /* Create evaluation stack */
-    stack = createBigNumStack(64);
+    stack = createBigNumStack(64, arena);
     if (stack == NULL) {
         evalResult.error = EVAL_ERROR_MEMORY;
         return evalResult;
@@ -249,7 +253,7 @@ EvalResult evaluatePostfix(Token* tokens) {
                         evalResult.error = EVAL_ERROR_DIVISION_BY_ZERO;
                         return evalResult;
                     }
-                    result = modulo(left, right);
+                    divmod(left, right, NULL, &result);
                     break;
                 case '^':
                     /* Check for 0^(negative) which is division by zero */
@@ -312,9 +316,23 @@ EvalResult evaluatePostfix(Token* tokens) {
         return evalResult;
     }
 
-    /* Cleanup and return */
-    free(stack->items);
-    free(stack);
+    /* Cleanup and return (the stack is empty now) */
+    destroyBigNumStack(stack);
+
+    return evalResult;
+}
+
+/**
+ * @brief Evaluates a postfix expression
+ */
+EvalResult evaluatePostfix(Token* tokens, Arena* arena) {
+    EvalResult evalResult;
+    Arena* previous;
+
+    /* Every intermediate BigNum comes from the arena for this evaluation */
+    previous = setBigNumArena(arena);
+    evalResult = evaluateTokens(tokens, arena);
+    setBigNumArena(previous);
 
     return evalResult;
 }
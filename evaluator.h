@@ -36,10 +36,16 @@ typedef struct {
 /**
  * @brief Evaluates a postfix expression
  *
+ * When an arena is given, the evaluation stack and every intermediate
+ * BigNum (including the result) are allocated from it, so the result
+ * stays valid only until the arena is reset; copy it with copyBigNum()
+ * outside the arena to keep it longer.
+ *
  * @param tokens Array of tokens in postfix order (NULL-terminated)
+ * @param arena Arena to allocate from, or NULL for the heap
  * @return EvalResult containing result and error code
  */
-EvalResult evaluatePostfix(Token* tokens);
+EvalResult evaluatePostfix(Token* tokens, Arena* arena);
 
 /**
  * @brief Gets human-readable error message for evaluation error
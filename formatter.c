@@ -5,160 +5,219 @@
 
 #include "formatter.h"
 #include "bignum_ops.h"
+#include "bignum_math.h"
+#include "bignum_limbs.h"
 #include "utils.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-/* Helper: Convert BigNum to binary string (positive only) */
-static char* decimalToBinary(const BigNum* num) {
-    BigNum* current;
-    BigNum* two;
-    BigNum* quotient;
-    BigNum* remainder;
-    char* binary;
-    char* reversed;
-    size_t capacity;
-    size_t length;
+/* Decimal output is produced in chunks of 9 digits (10^9 fits in a limb) */
+#define DECIMAL_CHUNK_DIGITS 9
+#define DECIMAL_CHUNK_BASE 1000000000
 
-    if (isZero(num)) {
-        binary = (char*)malloc(2);
-        if (binary) {
-            binary[0] = '0';
-            binary[1] = '\0';
-        }
-        return binary;
-    }
+/* Helper: Value of a lowercase hex digit character */
+static unsigned int digitValue(char c) {
+    return c <= '9' ? (unsigned int)(c - '0') : (unsigned int)(c - 'a' + 10);
+}
 
-    capacity = 256;
-    binary = (char*)malloc(capacity);
-    if (binary == NULL) return NULL;
+/*
+ * Helper: Formats a BigNum in two's complement with digitBits bits per
+ * digit (1 for binary, 4 for hex) after a two-character prefix
+ *
+ * The limbs are already base-2^32 words, so each one yields
+ * LIMB_BITS / digitBits digits with shifts and masks. Negative values
+ * are complemented word by word (~m + carry, the carry surviving only
+ * through zero words) while walking from the least significant limb,
+ * and the digits are written backwards into a preallocated buffer. A
+ * sign digit goes in front, then redundant leading digits are dropped
+ * so exactly one digit carries the sign bit.
+ */
+static char* formatTwosComplement(const BigNum* num, unsigned int digitBits, const char* prefix) {
+    static const char digitChars[] = "0123456789abcdef";
+    const Limb mask = ((Limb)1 << digitBits) - 1;
+    const size_t perLimb = LIMB_BITS / digitBits;
+    char* result;
+    char* digits;
+    char* p;
+    size_t count;
+    size_t skip;
+    size_t i, j;
+    unsigned int signBit;
+    Limb carry;
 
-    current = copyBigNum(num);
-    if (current == NULL) {
-        free(binary);
-        return NULL;
-    }
+    /* Sign digit + digits of every limb + null */
+    count = num->length * perLimb + 1;
+    result = (char*)malloc(2 + count + 1);
+    if (result == NULL) return NULL;
 
-    two = createBigNum("2");
-    if (two == NULL) {
-        free(binary);
-        destroyBigNum(current);
-        return NULL;
-    }
+    result[0] = prefix[0];
+    result[1] = prefix[1];
+    digits = result + 2;
 
-    length = 0;
-
-    /* Repeatedly divide by 2, collecting remainders */
-    while (!isZero(current)) {
-        /* Grow buffer if needed */
-        if (length + 1 >= capacity) {
-            char* newBinary;
-            capacity *= 2;
-            newBinary = (char*)realloc(binary, capacity);
-            if (newBinary == NULL) {
-                free(binary);
-                destroyBigNum(current);
-                destroyBigNum(two);
-                return NULL;
-            }
-            binary = newBinary;
-        }
+    p = digits + count;
+    *p = '\0';
+    carry = num->isNegative ? 1 : 0;
+    for (i = 0; i < num->length; i++) {
+        Limb word = num->limbs[i];
 
-        /* Get remainder (0 or 1) */
-        remainder = modulo(current, two);
-        if (remainder == NULL) {
-            free(binary);
-            destroyBigNum(current);
-            destroyBigNum(two);
-            return NULL;
+        if (num->isNegative) {
+            Limb magnitude = word;
+            word = ~magnitude + carry;
+            if (magnitude != 0) carry = 0;
         }
-
-        binary[length++] = isZero(remainder) ? '0' : '1';
-        destroyBigNum(remainder);
-
-        /* Divide by 2 */
-        quotient = divide(current, two);
-        destroyBigNum(current);
-        if (quotient == NULL) {
-            free(binary);
-            destroyBigNum(two);
-            return NULL;
+        for (j = 0; j < perLimb; j++) {
+            *--p = digitChars[word & mask];
+            word >>= digitBits;
         }
-        current = quotient;
     }
+    *--p = num->isNegative ? digitChars[mask] : '0';
 
-    binary[length] = '\0';
-    destroyBigNum(current);
-    destroyBigNum(two);
-
-    /* Reverse (we built it backwards) */
-    reversed = stringDuplicate(binary);
-    if (reversed) {
-        reverseString(reversed);
+    /* Drop sign digits while the next digit's top bit repeats the sign */
+    signBit = num->isNegative ? 1 : 0;
+    skip = 0;
+    while (skip + 1 < count && digits[skip] == digits[0] &&
+           (digitValue(digits[skip + 1]) >> (digitBits - 1)) == signBit) {
+        skip++;
     }
-    free(binary);
+    memmove(digits, digits + skip, count - skip + 1);
 
-    return reversed;
+    return result;
 }
 
-/* Helper: Invert binary string and add 1 (two's complement) */
-static char* applyTwosComplement(const char* binary) {
-    char* inverted;
-    size_t len;
-    size_t i;
-    int carry;
+/*
+ * Helper: Writes a magnitude as exactly width decimal digits
+ *
+ * width is a multiple of DECIMAL_CHUNK_DIGITS and the value must fit;
+ * the digits are zero-padded on the left. Peels off base-10^9 chunks
+ * with repeated single-limb division, which is quadratic in length and
+ * used only for short blocks.
+ */
+static bool writeDecimalChunks(const Limb* limbs, size_t length, char* out, size_t width) {
+    Limb* work;
+    size_t workLen;
+    int j;
+
+    work = NULL;
+    if (length > 0) {
+        work = (Limb*)malloc(length * sizeof(Limb));
+        if (work == NULL) return false;
+        memcpy(work, limbs, length * sizeof(Limb));
+    }
+    workLen = length;
+
+    /* Least significant chunk first, from the end of the block */
+    while (width > 0) {
+        Limb chunk = 0;
+        if (workLen > 0) {
+            chunk = limbsDivRem1(work, work, workLen, DECIMAL_CHUNK_BASE);
+            workLen = limbsNormalize(work, workLen);
+        }
+        width -= DECIMAL_CHUNK_DIGITS;
+        for (j = DECIMAL_CHUNK_DIGITS - 1; j >= 0; j--) {
+            out[width + (size_t)j] = (char)('0' + chunk % 10);
+            chunk /= 10;
+        }
+    }
+
+    free(work);
+    return true;
+}
 
-    len = strlen(binary);
-    inverted = (char*)malloc(len + 2);  /* Extra space for possible overflow */
-    if (inverted == NULL) return NULL;
+/*
+ * Helper: Writes a magnitude below 10^(9 * 2^level) as exactly
+ * 9 * 2^level zero-padded decimal digits, by divide and conquer
+ *
+ * One divmod() by the cached 10^(9 * 2^(level-1)) splits the value into
+ * the high and low half of the digits, which are written recursively.
+ * With the subquadratic divider this beats the chunk loop on long
+ * numbers.
+ */
+static bool writeDecimalBlock(const BigNum* value, unsigned int level, char* out) {
+    BigNum* high;
+    BigNum* low;
+    size_t width, half;
+    bool ok;
 
-    /* Invert all bits */
-    for (i = 0; i < len; i++) {
-        inverted[i] = (binary[i] == '0') ? '1' : '0';
-    }
-    inverted[len] = '\0';
-
-    /* Add 1 */
-    carry = 1;
-    for (i = len; i > 0 && carry; i--) {
-        if (inverted[i - 1] == '0') {
-            inverted[i - 1] = '1';
-            carry = 0;
-        } else {
-            inverted[i - 1] = '0';
-        }
+    width = (size_t)POWER_OF_TEN_DIGITS << level;
+    if (level == 0 || width <= DECIMAL_SPLIT_DIGITS) {
+        return writeDecimalChunks(value->limbs, value->length, out, width);
     }
+    half = width / 2;
 
-    /* If still have carry, prepend 1 */
-    if (carry) {
-        memmove(inverted + 1, inverted, len + 1);
-        inverted[0] = '1';
+    /* A limb holds fewer than 10 digits: the high half is all zeros */
+    if (value->length * 10 <= half) {
+        memset(out, '0', half);
+        return writeDecimalBlock(value, level - 1, out + half);
     }
 
-    return inverted;
+    high = NULL;
+    low = NULL;
+    ok = divmod(value, cachedPowerOfTen(level - 1), &high, &low) &&
+         writeDecimalBlock(high, level - 1, out) &&
+         writeDecimalBlock(low, level - 1, out + half);
+
+    destroyBigNum(high);
+    destroyBigNum(low);
+    return ok;
 }
 
 /**
  * @brief Formats a BigNum as a decimal string
  */
 char* formatDecimal(const BigNum* num) {
+    BigNum* magnitude;
     char* result;
-    size_t len;
+    char* digits;
+    size_t maxDigits;
+    size_t width;
+    size_t skip;
+    unsigned int level;
+    bool ok;
 
-    if (num == NULL || num->digits == NULL) return NULL;
+    if (num == NULL || num->limbs == NULL) return NULL;
 
-    len = strlen(num->digits);
+    if (isZero(num)) {
+        return stringDuplicate("0");
+    }
+
+    /* Each limb holds fewer than 10 decimal digits; round up to a block */
+    maxDigits = num->length * 10;
+    level = 0;
+    while (((size_t)POWER_OF_TEN_DIGITS << level) < maxDigits) {
+        level++;
+    }
+    width = (size_t)POWER_OF_TEN_DIGITS << level;
 
     /* Allocate: digits + possible minus + null */
-    result = (char*)malloc(len + 2);
+    result = (char*)malloc(width + 2);
     if (result == NULL) return NULL;
 
-    if (num->isNegative && strcmp(num->digits, "0") != 0) {
-        result[0] = '-';
-        strcpy(result + 1, num->digits);
-    } else {
-        strcpy(result, num->digits);
+    digits = result;
+    if (num->isNegative) {
+        *digits++ = '-';
+    }
+
+    /* The copy shares num's limbs; only its sign is cleared */
+    magnitude = copyBigNum(num);
+    ok = magnitude != NULL;
+    if (ok) {
+        magnitude->isNegative = false;
+        ok = writeDecimalBlock(magnitude, level, digits);
+        destroyBigNum(magnitude);
+    }
+    if (!ok) {
+        free(result);
+        return NULL;
+    }
+
+    /* Drop the zero padding in front of the top digit */
+    skip = 0;
+    while (digits[skip] == '0') {
+        skip++;
     }
+    memmove(digits, digits + skip, width - skip);
+    digits[width - skip] = '\0';
 
     return result;
 }
@@ -167,231 +226,16 @@ char* formatDecimal(const BigNum* num) {
  * @brief Formats a BigNum as a binary string with "0b" prefix
  */
 char* formatBinary(const BigNum* num) {
-    char* binary;
-    char* withPrefix;
-    size_t len;
-    char leadingBit;
-
-    if (num == NULL) return NULL;
-
-    /* Handle zero specially */
-    if (isZero(num)) {
-        withPrefix = (char*)malloc(4);
-        if (withPrefix) {
-            strcpy(withPrefix, "0b0");
-        }
-        return withPrefix;
-    }
-
-    if (!num->isNegative) {
-        /* Positive: standard conversion */
-        BigNum* abs = copyBigNum(num);
-        abs->isNegative = false;
-
-        binary = decimalToBinary(abs);
-        destroyBigNum(abs);
-        if (binary == NULL) return NULL;
-
-        /* Ensure leading bit is 0 (indicates positive) */
-        leadingBit = binary[0];
-        if (leadingBit == '1') {
-            /* Prepend a 0 */
-            len = strlen(binary);
-            withPrefix = (char*)malloc(len + 4);  /* "0b" + "0" + binary + null */
-            if (withPrefix) {
-                strcpy(withPrefix, "0b0");
-                strcat(withPrefix, binary);
-            }
-            free(binary);
-        } else {
-            /* Already has leading 0 */
-            withPrefix = (char*)malloc(strlen(binary) + 3);
-            if (withPrefix) {
-                strcpy(withPrefix, "0b");
-                strcat(withPrefix, binary);
-            }
-            free(binary);
-        }
-    } else {
-        /* Negative: two's complement */
-        BigNum* abs = copyBigNum(num);
-        char* complement;
-
-        abs->isNegative = false;
-
-        binary = decimalToBinary(abs);
-        destroyBigNum(abs);
-        if (binary == NULL) return NULL;
-
-        /* Apply two's complement */
-        complement = applyTwosComplement(binary);
-        free(binary);
-        if (complement == NULL) return NULL;
-
-        /* Ensure MSB is 1 for negative numbers in two's complement */
-        if (complement[0] == '0') {
-            /* Need to prepend 1 to indicate negative */
-            size_t len = strlen(complement);
-            char* newComp = (char*)malloc(len + 2);
-            if (newComp) {
-                newComp[0] = '1';
-                strcpy(newComp + 1, complement);
-                free(complement);
-                complement = newComp;
-            }
-        } else {
-            /* MSB is already 1, remove redundant leading 1s */
-            /* Can remove '1' bits while next bit is also '1' */
-            while (complement[0] == '1' && complement[1] == '1') {
-                memmove(complement, complement + 1, strlen(complement));
-            }
-        }
+    if (num == NULL || num->limbs == NULL) return NULL;
 
-        withPrefix = (char*)malloc(strlen(complement) + 3);
-        if (withPrefix) {
-            strcpy(withPrefix, "0b");
-            strcat(withPrefix, complement);
-        }
-        free(complement);
-    }
-
-    return withPrefix;
+    return formatTwosComplement(num, 1, "0b");
 }
 
 /**
  * @brief Formats a BigNum as a hexadecimal string with "0x" prefix
  */
 char* formatHexadecimal(const BigNum* num) {
-    char* binary;
-    char* hex;
-    size_t binLen;
-    size_t hexLen;
-    size_t i, j;
-    int val;
-    const char hexDigits[] = "0123456789abcdef";
-    char* withPrefix;
-
-    if (num == NULL) return NULL;
-
-    /* Handle zero specially */
-    if (isZero(num)) {
-        withPrefix = (char*)malloc(4);
-        if (withPrefix) {
-            strcpy(withPrefix, "0x0");
-        }
-        return withPrefix;
-    }
-
-    /* Get binary representation first */
-    if (!num->isNegative) {
-        /* Positive */
-        BigNum* abs = copyBigNum(num);
-        abs->isNegative = false;
-
-        binary = decimalToBinary(abs);
-        destroyBigNum(abs);
-        if (binary == NULL) return NULL;
-
-        /* Ensure leading bit is 0 (pad to multiple of 4) */
-        binLen = strlen(binary);
-        while (binLen % 4 != 0 || binary[0] == '1') {
-            char* newBinary = (char*)malloc(binLen + 2);
-            if (newBinary == NULL) {
-                free(binary);
-                return NULL;
-            }
-            newBinary[0] = '0';
-            strcpy(newBinary + 1, binary);
-            free(binary);
-            binary = newBinary;
-            binLen++;
-        }
-    } else {
-        /* Negative: two's complement */
-        BigNum* abs = copyBigNum(num);
-        char* complement;
-
-        abs->isNegative = false;
-
-        binary = decimalToBinary(abs);
-        destroyBigNum(abs);
-        if (binary == NULL) return NULL;
-
-        /* Ensure at least one leading 0 so two's complement gives leading 1 */
-        binLen = strlen(binary);
-        if (binary[0] == '1') {
-            char* newBinary = (char*)malloc(binLen + 2);
-            if (newBinary == NULL) {
-                free(binary);
-                return NULL;
-            }
-            newBinary[0] = '0';
-            strcpy(newBinary + 1, binary);
-            free(binary);
-            binary = newBinary;
-            binLen++;
-        }
-
-        /* Pad to multiple of 4 */
-        while (binLen % 4 != 0) {
-            char* newBinary = (char*)malloc(binLen + 2);
-            if (newBinary == NULL) {
-                free(binary);
-                return NULL;
-            }
-            newBinary[0] = '0';
-            strcpy(newBinary + 1, binary);
-            free(binary);
-            binary = newBinary;
-            binLen++;
-        }
-
-        /* Apply two's complement */
-        complement = applyTwosComplement(binary);
-        free(binary);
-        if (complement == NULL) return NULL;
-
-        binary = complement;
-        binLen = strlen(binary);
-    }
-
-    /* Convert binary to hex (4 bits = 1 hex digit) */
-    hexLen = binLen / 4;
-    hex = (char*)malloc(hexLen + 1);
-    if (hex == NULL) {
-        free(binary);
-        return NULL;
-    }
-
-    for (i = 0, j = 0; i < binLen; i += 4, j++) {
-        val = ((binary[i] - '0') << 3) |
-              ((binary[i + 1] - '0') << 2) |
-              ((binary[i + 2] - '0') << 1) |
-              (binary[i + 3] - '0');
-        hex[j] = hexDigits[val];
-    }
-    hex[hexLen] = '\0';
-    free(binary);
-
-    /* Remove unnecessary leading digits (but preserve sign indication) */
-    if (!num->isNegative) {
-        /* Positive: remove leading 0s but keep one leading 0-7 digit */
-        while (hex[0] == '0' && hex[1] != '\0' && hex[1] < '8') {
-            memmove(hex, hex + 1, strlen(hex));
-        }
-    } else {
-        /* Negative: remove leading Fs but keep one leading 8-F digit */
-        while (hex[0] == 'f' && hex[1] != '\0' && hex[1] >= '8') {
-            memmove(hex, hex + 1, strlen(hex));
-        }
-    }
-
-    withPrefix = (char*)malloc(strlen(hex) + 3);
-    if (withPrefix) {
-        strcpy(withPrefix, "0x");
-        strcat(withPrefix, hex);
-    }
-    free(hex);
+    if (num == NULL || num->limbs == NULL) return NULL;
 
-    return withPrefix;
+    return formatTwosComplement(num, 4, "0x");
 }
@@ -4,47 +4,61 @@
  */
 
 #include "parser.h"
+#include "arena.h"
 #include "converter.h"
 #include "utils.h"
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 
+/* Helper: Free the values of count tokens and the token array itself */
+static void releaseTokens(Arena* arena, Token* tokens, int count) {
+    int i;
+
+    for (i = 0; i < count; i++) {
+        arenaOrHeapFree(arena, tokens[i].value);
+    }
+    arenaOrHeapFree(arena, tokens);
+}
+
 /* Helper: Operator stack for Shunting Yard */
 typedef struct {
     char* operators;
     int top;
     int capacity;
+    Arena* arena;
 } OperatorStack;
 
 /* Helper: Create operator stack */
-static OperatorStack* createOperatorStack(int capacity) {
-    OperatorStack* stack = (OperatorStack*)malloc(sizeof(OperatorStack));
+static OperatorStack* createOperatorStack(int capacity, Arena* arena) {
+    OperatorStack* stack = (OperatorStack*)arenaOrHeapAlloc(arena, sizeof(OperatorStack));
     if (stack == NULL) return NULL;
 
-    stack->operators = (char*)malloc(capacity);
+    stack->operators = (char*)arenaOrHeapAlloc(arena, capacity);
     if (stack->operators == NULL) {
-        free(stack);
+        arenaOrHeapFree(arena, stack);
         return NULL;
     }
 
     stack->top = -1;
     stack->capacity = capacity;
+    stack->arena = arena;
     return stack;
 }
 
 /* Helper: Destroy operator stack */
 static void destroyOperatorStack(OperatorStack* stack) {
     if (stack != NULL) {
-        free(stack->operators);
-        free(stack);
+        arenaOrHeapFree(stack->arena, stack->operators);
+        arenaOrHeapFree(stack->arena, stack);
     }
 }
 
 /* Helper: Push to operator stack */
 static bool pushOperator(OperatorStack* stack, char op) {
     if (stack->top >= stack->capacity - 1) {
-        char* newOps = (char*)realloc(stack->operators, stack->capacity * 2);
+        char* newOps = (char*)arenaOrHeapGrow(stack->arena, stack->operators,
+                                              stack->capacity, stack->capacity * 2);
         if (newOps == NULL) return false;
         stack->operators = newOps;
         stack->capacity *= 2;
@@ -110,9 +124,11 @@ static bool isOperator(char c) {
 bool validateExpression(const char* expr) {
     int parenCount = 0;
     const char* p = expr;
+    const char* end;
     bool expectOperand = true;  /* true if expecting number/operand */
 
     if (expr == NULL || *expr == '\0') return false;
+    end = expr + strlen(expr);
 
     while (*p != '\0') {
         /* Skip whitespace */
@@ -170,17 +186,17 @@ bool validateExpression(const char* expr) {
             if (*p == '0' && (*(p+1) == 'b' || *(p+1) == 'B')) {
                 p += 2;
                 numStart = p;
-                while (*p == '0' || *p == '1') p++;
+                p += spanBinaryDigits(p, (size_t)(end - p));
                 /* Binary number must have at least one digit after 0b */
                 if (p == numStart) return false;
             } else if (*p == '0' && (*(p+1) == 'x' || *(p+1) == 'X')) {
                 p += 2;
                 numStart = p;
-                while (isHexDigitChar(*p)) p++;
+                p += spanHexDigits(p, (size_t)(end - p));
                 /* Hex number must have at least one digit after 0x */
                 if (p == numStart) return false;
             } else {
-                while (isDigitChar(*p)) p++;
+                p += spanDecimalDigits(p, (size_t)(end - p));
             }
 
             expectOperand = false;
@@ -199,19 +215,21 @@ bool validateExpression(const char* expr) {
 }
 
 /* Helper: Tokenize expression into array */
-static Token* tokenizeExpression(const char* expr, int* tokenCount) {
+static Token* tokenizeExpression(const char* expr, int* tokenCount, Arena* arena) {
     Token* tokens;
     int capacity;
     int count;
     const char* p;
+    const char* end;
     bool expectOperand;
 
     capacity = 64;
-    tokens = (Token*)malloc(capacity * sizeof(Token));
+    tokens = (Token*)arenaOrHeapAlloc(arena, capacity * sizeof(Token));
     if (tokens == NULL) return NULL;
 
     count = 0;
     p = expr;
+    end = expr + strlen(expr);
     expectOperand = true;
 
     while (*p != '\0') {
@@ -223,13 +241,10 @@ static Token* tokenizeExpression(const char* expr, int* tokenCount) {
 
         /* Grow array if needed */
         if (count >= capacity - 1) {
-            Token* newTokens = (Token*)realloc(tokens, capacity * 2 * sizeof(Token));
+            Token* newTokens = (Token*)arenaOrHeapGrow(arena, tokens, capacity * sizeof(Token),
+                                                       capacity * 2 * sizeof(Token));
             if (newTokens == NULL) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    free(tokens[i].value);
-                }
-                free(tokens);
+                releaseTokens(arena, tokens, count);
                 return NULL;
             }
             tokens = newTokens;
@@ -239,13 +254,9 @@ static Token* tokenizeExpression(const char* expr, int* tokenCount) {
         /* Left parenthesis */
         if (*p == '(') {
             tokens[count].type = TOKEN_LPAREN;
-            tokens[count].value = (char*)malloc(2);
+            tokens[count].value = (char*)arenaOrHeapAlloc(arena, 2);
             if (tokens[count].value == NULL) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    free(tokens[i].value);
-                }
-                free(tokens);
+                releaseTokens(arena, tokens, count);
                 return NULL;
             }
             tokens[count].value[0] = '(';
@@ -259,13 +270,9 @@ static Token* tokenizeExpression(const char* expr, int* tokenCount) {
         /* Right parenthesis */
         if (*p == ')') {
             tokens[count].type = TOKEN_RPAREN;
-            tokens[count].value = (char*)malloc(2);
+            tokens[count].value = (char*)arenaOrHeapAlloc(arena, 2);
             if (tokens[count].value == NULL) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    free(tokens[i].value);
-                }
-                free(tokens);
+                releaseTokens(arena, tokens, count);
                 return NULL;
             }
             tokens[count].value[0] = ')';
@@ -279,13 +286,9 @@ static Token* tokenizeExpression(const char* expr, int* tokenCount) {
         /* Factorial (postfix) */
         if (*p == '!') {
             tokens[count].type = TOKEN_FACTORIAL;
-            tokens[count].value = (char*)malloc(2);
+            tokens[count].value = (char*)arenaOrHeapAlloc(arena, 2);
             if (tokens[count].value == NULL) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    free(tokens[i].value);
-                }
-                free(tokens);
+                releaseTokens(arena, tokens, count);
                 return NULL;
             }
             tokens[count].value[0] = '!';
@@ -299,13 +302,9 @@ static Token* tokenizeExpression(const char* expr, int* tokenCount) {
         /* Unary minus */
         if (*p == '-' && expectOperand) {
             tokens[count].type = TOKEN_UNARY_MINUS;
-            tokens[count].value = (char*)malloc(2);
+            tokens[count].value = (char*)arenaOrHeapAlloc(arena, 2);
             if (tokens[count].value == NULL) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    free(tokens[i].value);
-                }
-                free(tokens);
+                releaseTokens(arena, tokens, count);
                 return NULL;
             }
             tokens[count].value[0] = '-';
@@ -319,13 +318,9 @@ static Token* tokenizeExpression(const char* expr, int* tokenCount) {
         /* Binary operators */
         if (isOperator(*p)) {
             tokens[count].type = TOKEN_OPERATOR;
-            tokens[count].value = (char*)malloc(2);
+            tokens[count].value = (char*)arenaOrHeapAlloc(arena, 2);
             if (tokens[count].value == NULL) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    free(tokens[i].value);
-                }
-                free(tokens);
+                releaseTokens(arena, tokens, count);
                 return NULL;
             }
             tokens[count].value[0] = *p;
@@ -347,42 +342,30 @@ static Token* tokenizeExpression(const char* expr, int* tokenCount) {
             if (*p == '0' && (*(p+1) == 'b' || *(p+1) == 'B')) {
                 p += 2;
                 digitStart = p;
-                while (*p == '0' || *p == '1') p++;
+                p += spanBinaryDigits(p, (size_t)(end - p));
                 /* Must have at least one binary digit (should be caught by validator) */
                 if (p == digitStart) {
-                    int i;
-                    for (i = 0; i < count; i++) {
-                        free(tokens[i].value);
-                    }
-                    free(tokens);
+                    releaseTokens(arena, tokens, count);
                     return NULL;
                 }
             } else if (*p == '0' && (*(p+1) == 'x' || *(p+1) == 'X')) {
                 p += 2;
                 digitStart = p;
-                while (isHexDigitChar(*p)) p++;
+                p += spanHexDigits(p, (size_t)(end - p));
                 /* Must have at least one hex digit (should be caught by validator) */
                 if (p == digitStart) {
-                    int i;
-                    for (i = 0; i < count; i++) {
-                        free(tokens[i].value);
-                    }
-                    free(tokens);
+                    releaseTokens(arena, tokens, count);
                     return NULL;
                 }
             } else {
-                while (isDigitChar(*p)) p++;
+                p += spanDecimalDigits(p, (size_t)(end - p));
             }
 
             len = (size_t)(p - start);
             tokens[count].type = TOKEN_NUMBER;
-            tokens[count].value = (char*)malloc(len + 1);
+            tokens[count].value = (char*)arenaOrHeapAlloc(arena, len + 1);
             if (tokens[count].value == NULL) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    free(tokens[i].value);
-                }
-                free(tokens);
+                releaseTokens(arena, tokens, count);
                 return NULL;
             }
             strncpy(tokens[count].value, start, len);
@@ -403,7 +386,7 @@ static Token* tokenizeExpression(const char* expr, int* tokenCount) {
 /**
  * @brief Converts infix expression to postfix (Shunting Yard algorithm)
  */
-Token* infixToPostfix(const char* expr) {
+Token* infixToPostfix(const char* expr, Arena* arena) {
     Token* infix;
     Token* postfix;
     OperatorStack* opStack;
@@ -417,27 +400,21 @@ Token* infixToPostfix(const char* expr) {
     if (!validateExpression(expr)) return NULL;
 
     /* Tokenize */
-    infix = tokenizeExpression(expr, &infixCount);
+    infix = tokenizeExpression(expr, &infixCount, arena);
     if (infix == NULL) return NULL;
 
     /* Allocate postfix array (worst case: same size + 1 for NULL terminator) */
-    postfix = (Token*)malloc((infixCount + 1) * sizeof(Token));
+    postfix = (Token*)arenaOrHeapAlloc(arena, (infixCount + 1) * sizeof(Token));
     if (postfix == NULL) {
-        for (i = 0; i < infixCount; i++) {
-            free(infix[i].value);
-        }
-        free(infix);
+        releaseTokens(arena, infix, infixCount);
         return NULL;
     }
 
     /* Create operator stack */
-    opStack = createOperatorStack(infixCount);
+    opStack = createOperatorStack(infixCount, arena);
     if (opStack == NULL) {
-        for (i = 0; i < infixCount; i++) {
-            free(infix[i].value);
-        }
-        free(infix);
-        free(postfix);
+        releaseTokens(arena, infix, infixCount);
+        arenaOrHeapFree(arena, postfix);
         return NULL;
     }
 
@@ -455,14 +432,14 @@ Token* infixToPostfix(const char* expr) {
         /* Left parenthesis: push to stack */
         else if (current.type == TOKEN_LPAREN) {
             pushOperator(opStack, '(');
-            free(current.value);
+            arenaOrHeapFree(arena, current.value);
         }
         /* Right parenthesis: pop until matching left paren */
         else if (current.type == TOKEN_RPAREN) {
             while (!isOperatorStackEmpty(opStack) && peekOperator(opStack) != '(') {
                 char op = popOperator(opStack);
                 postfix[postfixCount].type = (op == '~') ? TOKEN_UNARY_MINUS : TOKEN_OPERATOR;
-                postfix[postfixCount].value = (char*)malloc(2);
+                postfix[postfixCount].value = (char*)arenaOrHeapAlloc(arena, 2);
                 postfix[postfixCount].value[0] = op;
                 postfix[postfixCount].value[1] = '\0';
                 postfixCount++;
@@ -471,12 +448,12 @@ Token* infixToPostfix(const char* expr) {
             if (!isOperatorStackEmpty(opStack)) {
                 popOperator(opStack);
             }
-            free(current.value);
+            arenaOrHeapFree(arena, current.value);
         }
         /* Unary minus: treat as operator with high precedence */
         else if (current.type == TOKEN_UNARY_MINUS) {
             pushOperator(opStack, '~');  /* Use ~ to represent unary minus */
-            free(current.value);
+            arenaOrHeapFree(arena, current.value);
         }
         /* Factorial: immediately add to output (postfix operator) */
         else if (current.type == TOKEN_FACTORIAL) {
@@ -508,14 +485,14 @@ Token* infixToPostfix(const char* expr) {
 
                 topOp = popOperator(opStack);
                 postfix[postfixCount].type = (topOp == '~') ? TOKEN_UNARY_MINUS : TOKEN_OPERATOR;
-                postfix[postfixCount].value = (char*)malloc(2);
+                postfix[postfixCount].value = (char*)arenaOrHeapAlloc(arena, 2);
                 postfix[postfixCount].value[0] = topOp;
                 postfix[postfixCount].value[1] = '\0';
                 postfixCount++;
             }
 
             pushOperator(opStack, op);
-            free(current.value);
+            arenaOrHeapFree(arena, current.value);
         }
     }
 
@@ -524,7 +501,7 @@ Token* infixToPostfix(const char* expr) {
         char op = popOperator(opStack);
         if (op != '(') {  /* Ignore any stray parentheses */
             postfix[postfixCount].type = (op == '~') ? TOKEN_UNARY_MINUS : TOKEN_OPERATOR;
-            postfix[postfixCount].value = (char*)malloc(2);
+            postfix[postfixCount].value = (char*)arenaOrHeapAlloc(arena, 2);
             postfix[postfixCount].value[0] = op;
             postfix[postfixCount].value[1] = '\0';
             postfixCount++;
@@ -537,7 +514,7 @@ Token* infixToPostfix(const char* expr) {
 
     /* Cleanup */
     destroyOperatorStack(opStack);
-    free(infix);
+    arenaOrHeapFree(arena, infix);
 
     return postfix;
 }
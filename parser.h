@@ -10,6 +10,7 @@
 #ifndef PARSER_H
 #define PARSER_H
 
+#include "arena.h"
 #include <stdbool.h>
 
 /**
@@ -50,14 +51,21 @@ bool validateExpression(const char* expr);
 /**
  * @brief Converts infix expression to postfix (Shunting Yard algorithm)
  *
+ * When an arena is given, the token array, token values and working
+ * stacks are all allocated from it and released by resetArena();
+ * otherwise they come from the heap and must be freed with freeTokens().
+ *
  * @param expr Infix expression string
+ * @param arena Arena to allocate from, or NULL for the heap
  * @return Array of tokens in postfix order (NULL-terminated), or NULL on error
  */
-Token* infixToPostfix(const char* expr);
+Token* infixToPostfix(const char* expr, Arena* arena);
 
 /**
  * @brief Frees memory allocated for token array
  *
+ * Only for tokens created without an arena.
+ *
  * @param tokens Token array to free (NULL-terminated)
  */
 void freeTokens(Token* tokens);
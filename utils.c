@@ -8,10 +8,16 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdio.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #define INITIAL_BUFFER_SIZE 256
 #define MAX_LINE_LENGTH 10000
 
+/* A 64-bit word with every byte set to b */
+#define SWAR_BYTES(b) ((~(uint64_t)0 / 0xFF) * (uint64_t)(b))
+
 /* Helper function to check if character is whitespace */
 static bool isWhitespaceChar(char c) {
     return c == ' ' || c == '\t' || c == '\n' || c == '\r';
@@ -289,6 +295,150 @@ bool isHexDigitChar(char c) {
            (c >= 'A' && c <= 'F');
 }
 
+/* Helper: Load 8 bytes into a word (byte order does not matter per byte) */
+static uint64_t loadWord(const char* p) {
+    uint64_t word;
+
+    memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+/*
+ * Helper: Marks the bytes of x that lie in [lo, hi]
+ *
+ * Sets the high bit of every byte in range and clears everything else.
+ * lo and hi are 7-bit; each byte is compared on its low 7 bits with
+ * additions that cannot carry into the next byte, and bytes with the
+ * high bit set never match.
+ */
+static uint64_t bytesInRange(uint64_t x, unsigned int lo, unsigned int hi) {
+    uint64_t low7 = x & ~SWAR_BYTES(0x80);
+    uint64_t atLeastLo = low7 + SWAR_BYTES(0x80 - lo);
+    uint64_t aboveHi = low7 + SWAR_BYTES(0x7F - hi);
+
+    return atLeastLo & ~aboveHi & ~x & SWAR_BYTES(0x80);
+}
+
+/**
+ * @brief Returns the length of the run of decimal digits at the start of str
+ */
+size_t spanDecimalDigits(const char* str, size_t len) {
+    size_t i = 0;
+
+#ifdef __SSE2__
+    {
+        const __m128i below = _mm_set1_epi8('0' - 1);
+        const __m128i above = _mm_set1_epi8('9' + 1);
+
+        /* Bytes >= 0x80 are negative as signed chars, so they fail too */
+        for (; i + 16 <= len; i += 16) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(const void*)(str + i));
+            __m128i ok = _mm_and_si128(_mm_cmpgt_epi8(x, below), _mm_cmplt_epi8(x, above));
+            if (_mm_movemask_epi8(ok) != 0xFFFF) break;
+        }
+    }
+#endif
+
+    for (; i + 8 <= len; i += 8) {
+        if (bytesInRange(loadWord(str + i), '0', '9') != SWAR_BYTES(0x80)) break;
+    }
+
+    /* The block holding the first non-digit, and the tail */
+    while (i < len && isDigitChar(str[i])) {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * @brief Returns the length of the run of hex digits at the start of str
+ */
+size_t spanHexDigits(const char* str, size_t len) {
+    uint64_t x;
+    size_t i = 0;
+
+#ifdef __SSE2__
+    {
+        const __m128i digitBelow = _mm_set1_epi8('0' - 1);
+        const __m128i digitAbove = _mm_set1_epi8('9' + 1);
+        const __m128i letterBelow = _mm_set1_epi8('a' - 1);
+        const __m128i letterAbove = _mm_set1_epi8('f' + 1);
+        const __m128i lowerCase = _mm_set1_epi8(0x20);
+
+        for (; i + 16 <= len; i += 16) {
+            __m128i x16 = _mm_loadu_si128((const __m128i*)(const void*)(str + i));
+            __m128i folded = _mm_or_si128(x16, lowerCase);
+            __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(x16, digitBelow),
+                                          _mm_cmplt_epi8(x16, digitAbove));
+            __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(folded, letterBelow),
+                                           _mm_cmplt_epi8(folded, letterAbove));
+            if (_mm_movemask_epi8(_mm_or_si128(digit, letter)) != 0xFFFF) break;
+        }
+    }
+#endif
+
+    /* OR-ing 0x20 folds 'A'-'F' onto 'a'-'f' and no other byte onto them */
+    for (; i + 8 <= len; i += 8) {
+        x = loadWord(str + i);
+        if ((bytesInRange(x, '0', '9') | bytesInRange(x | SWAR_BYTES(0x20), 'a', 'f')) !=
+            SWAR_BYTES(0x80)) break;
+    }
+
+    while (i < len && isHexDigitChar(str[i])) {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * @brief Returns the length of the run of binary digits at the start of str
+ */
+size_t spanBinaryDigits(const char* str, size_t len) {
+    size_t i = 0;
+
+#ifdef __SSE2__
+    {
+        const __m128i zero = _mm_set1_epi8('0');
+        const __m128i one = _mm_set1_epi8('1');
+
+        for (; i + 16 <= len; i += 16) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(const void*)(str + i));
+            __m128i ok = _mm_or_si128(_mm_cmpeq_epi8(x, zero), _mm_cmpeq_epi8(x, one));
+            if (_mm_movemask_epi8(ok) != 0xFFFF) break;
+        }
+    }
+#endif
+
+    for (; i + 8 <= len; i += 8) {
+        if (bytesInRange(loadWord(str + i), '0', '1') != SWAR_BYTES(0x80)) break;
+    }
+
+    while (i < len && (str[i] == '0' || str[i] == '1')) {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * @brief Converts exactly eight decimal digits to an integer
+ */
+uint32_t parseEightDigits(const char* digits) {
+    uint64_t x = 0;
+    int i;
+
+    /* First digit in the lowest byte, whatever the machine's byte order */
+    for (i = 7; i >= 0; i--) {
+        x = (x << 8) | (unsigned char)digits[i];
+    }
+
+    /* Merge neighbours: pairs (x10 + 1), then quads (x100), then halves (x10^4) */
+    x = ((x & SWAR_BYTES(0x0F)) * (10 * 256 + 1)) >> 8;
+    x = ((x & (~(uint64_t)0 / 0xFFFF * 0xFF)) * (100 * 65536 + 1)) >> 16;
+    x = ((x & (~(uint64_t)0 / 0xFFFFFFFF * 0xFFFF)) * (((uint64_t)10000 << 32) + 1)) >> 32;
+
+    return (uint32_t)x;
+}
+
 /**
  * @brief Duplicates a string
  */
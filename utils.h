@@ -10,6 +10,8 @@
 #define UTILS_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 /**
  * @brief Removes leading and trailing whitespace from a string
@@ -76,6 +78,52 @@ bool isDigitChar(char c);
  */
 bool isHexDigitChar(char c);
 
+/**
+ * @brief Returns the length of the run of decimal digits at the start of str
+ *
+ * Classifies 16 bytes per step with SSE2 where available, otherwise 8
+ * bytes per step with portable SWAR arithmetic on 64-bit words. Never
+ * reads more than len bytes, so str need not be NUL-terminated.
+ *
+ * @param str Characters to scan
+ * @param len Number of characters available
+ * @return Number of leading characters that are '0'-'9'
+ */
+size_t spanDecimalDigits(const char* str, size_t len);
+
+/**
+ * @brief Returns the length of the run of hex digits at the start of str
+ *
+ * Vectorized like spanDecimalDigits().
+ *
+ * @param str Characters to scan
+ * @param len Number of characters available
+ * @return Number of leading characters that are 0-9, a-f or A-F
+ */
+size_t spanHexDigits(const char* str, size_t len);
+
+/**
+ * @brief Returns the length of the run of binary digits at the start of str
+ *
+ * Vectorized like spanDecimalDigits().
+ *
+ * @param str Characters to scan
+ * @param len Number of characters available
+ * @return Number of leading characters that are '0' or '1'
+ */
+size_t spanBinaryDigits(const char* str, size_t len);
+
+/**
+ * @brief Converts exactly eight decimal digits to an integer
+ *
+ * Combines the digits pairwise inside one 64-bit word (three multiplies)
+ * instead of eight multiply-adds. The digits must already be validated.
+ *
+ * @param digits Eight characters '0'-'9', most significant first
+ * @return Value of the digits (below 10^8)
+ */
+uint32_t parseEightDigits(const char* digits);
+
 /**
  * @brief Duplicates a string
  *